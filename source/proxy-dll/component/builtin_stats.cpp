@@ -0,0 +1,323 @@
+#include <std_include.hpp>
+#include "builtin_stats.hpp"
+#include "command.hpp"
+#include "gsc_funcs.hpp"
+#include "definitions/game.hpp"
+#include "loader/component_loader.hpp"
+
+#include <utilities/hook.hpp>
+#include <utilities/json_config.hpp>
+
+namespace builtin_stats
+{
+	namespace
+	{
+		constexpr size_t max_builtins = 0x1000;
+		constexpr size_t histogram_buckets = 16;
+		constexpr uint32_t default_dump_count = 50;
+
+		// functions only use the first parameter, methods get their entity ref in the second one
+		using builtin_call = void(*)(game::scriptInstance_t inst, uint64_t entref);
+
+		struct builtin_record
+		{
+			uint32_t canon_id;
+			game::scriptInstance_t inst;
+			bool method;
+			void* func;
+			void* stub;
+			size_t index;
+		};
+
+		// the builtins are counted by name, the aliases of a builtin share their function
+		struct record_key
+		{
+			game::scriptInstance_t inst;
+			bool method;
+			uint32_t canon_id;
+
+			bool operator==(const record_key& other) const = default;
+		};
+
+		struct record_key_hash
+		{
+			size_t operator()(const record_key& key) const
+			{
+				return std::hash<uint64_t>{}(static_cast<uint64_t>(key.canon_id) << 2 | static_cast<uint64_t>(key.inst) << 1 | key.method);
+			}
+		};
+
+		struct builtin_counters
+		{
+			std::atomic<uint64_t> calls{};
+			std::atomic<uint64_t> total_ns{};
+			std::array<std::atomic<uint64_t>, histogram_buckets> histogram{};
+		};
+
+		// counters of one thread, only written by this thread so the updates don't need to be atomic operations
+		struct thread_counters
+		{
+			std::array<builtin_counters, max_builtins> builtins{};
+		};
+
+		struct merged_counters
+		{
+			uint64_t calls{};
+			uint64_t total_ns{};
+			std::array<uint64_t, histogram_buckets> histogram{};
+		};
+
+		bool enabled{};
+
+		std::mutex records_mutex{};
+		std::deque<builtin_record> records{};
+		std::unordered_map<record_key, builtin_record*, record_key_hash> records_by_key{};
+		std::unordered_map<void*, builtin_record*> records_by_stub{};
+
+		std::mutex counters_mutex{};
+		std::vector<std::unique_ptr<thread_counters>> all_counters{};
+		std::vector<merged_counters> baseline{};
+		thread_local thread_counters* local_counters{};
+
+		thread_counters& get_thread_counters()
+		{
+			if (!local_counters)
+			{
+				std::lock_guard _(counters_mutex);
+				local_counters = all_counters.emplace_back(std::make_unique<thread_counters>()).get();
+			}
+
+			return *local_counters;
+		}
+
+		void add_counter(std::atomic<uint64_t>& counter, uint64_t value)
+		{
+			counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+		}
+
+		size_t get_bucket(uint64_t ns)
+		{
+			// first bucket is under 256ns, every bucket doubles the previous one
+			return std::min<size_t>(std::bit_width(ns >> 8), histogram_buckets - 1);
+		}
+
+		uint64_t get_bucket_limit(size_t bucket)
+		{
+			return 256ull << bucket;
+		}
+
+		void call_builtin(game::scriptInstance_t inst, uint64_t entref, builtin_record* record)
+		{
+			thread_counters& counters = get_thread_counters();
+
+			const auto start = std::chrono::steady_clock::now();
+			reinterpret_cast<builtin_call>(record->func)(inst, entref);
+			const auto ns = (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+
+			builtin_counters& c = counters.builtins[record->index];
+
+			add_counter(c.calls, 1);
+			add_counter(c.total_ns, ns);
+			add_counter(c.histogram[get_bucket(ns)], 1);
+		}
+
+		std::vector<merged_counters> merge_thread_counters()
+		{
+			std::vector<merged_counters> merged{};
+			{
+				std::lock_guard _(records_mutex);
+				merged.resize(records.size());
+			}
+
+			std::lock_guard _(counters_mutex);
+
+			for (const auto& counters : all_counters)
+			{
+				for (size_t i = 0; i < merged.size(); i++)
+				{
+					const builtin_counters& c = counters->builtins[i];
+					merged_counters& m = merged[i];
+
+					m.calls += c.calls.load(std::memory_order_relaxed);
+					m.total_ns += c.total_ns.load(std::memory_order_relaxed);
+
+					for (size_t b = 0; b < histogram_buckets; b++)
+					{
+						m.histogram[b] += c.histogram[b].load(std::memory_order_relaxed);
+					}
+				}
+			}
+
+			return merged;
+		}
+
+		std::vector<merged_counters> merge_counters()
+		{
+			std::vector<merged_counters> merged = merge_thread_counters();
+
+			std::lock_guard _(counters_mutex);
+
+			// remove what was counted before the last reset
+			for (size_t i = 0; i < merged.size() && i < baseline.size(); i++)
+			{
+				merged[i].calls -= baseline[i].calls;
+				merged[i].total_ns -= baseline[i].total_ns;
+
+				for (size_t b = 0; b < histogram_buckets; b++)
+				{
+					merged[i].histogram[b] -= baseline[i].histogram[b];
+				}
+			}
+
+			return merged;
+		}
+
+		uint64_t get_percentile(const merged_counters& m, uint64_t percent)
+		{
+			uint64_t target = (m.calls * percent + 99) / 100;
+			uint64_t count{};
+
+			for (size_t b = 0; b < histogram_buckets; b++)
+			{
+				count += m.histogram[b];
+
+				if (count >= target)
+				{
+					return get_bucket_limit(b);
+				}
+			}
+
+			return get_bucket_limit(histogram_buckets - 1);
+		}
+
+		void builtin_stats_f(const command::params& params)
+		{
+			if (!enabled)
+			{
+				logger::write(logger::LOG_TYPE_CONSOLE, "builtin stats are disabled, set gsc.builtin_stats in the config to enable them");
+				return;
+			}
+
+			if (params.size() > 1 && !_stricmp(params[1], "reset"))
+			{
+				std::vector<merged_counters> merged = merge_thread_counters();
+
+				std::lock_guard _(counters_mutex);
+				baseline = std::move(merged);
+
+				logger::write(logger::LOG_TYPE_CONSOLE, "builtin stats reset");
+				return;
+			}
+
+			size_t count = default_dump_count;
+
+			if (params.size() > 1)
+			{
+				count = (size_t)std::max(1, std::atoi(params[1]));
+			}
+
+			std::vector<merged_counters> merged = merge_counters();
+			std::vector<size_t> order{};
+
+			for (size_t i = 0; i < merged.size(); i++)
+			{
+				if (merged[i].calls)
+				{
+					order.emplace_back(i);
+				}
+			}
+
+			std::sort(order.begin(), order.end(), [&merged](size_t a, size_t b) { return merged[a].total_ns > merged[b].total_ns; });
+
+			logger::write(logger::LOG_TYPE_CONSOLE, std::format("{:>10} {:>10} {:>10} {:>10} {:>10}  {}", "calls", "total ms", "avg us", "p50 us<", "p99 us<", "builtin"));
+
+			std::lock_guard _(records_mutex);
+
+			for (size_t i = 0; i < order.size() && i < count; i++)
+			{
+				const merged_counters& m = merged[order[i]];
+				const builtin_record& record = records[order[i]];
+
+				logger::write(logger::LOG_TYPE_CONSOLE, std::format("{:>10} {:>10.3f} {:>10.3f} {:>10.3f} {:>10.3f}  [{}] {}{}",
+					m.calls, m.total_ns / 1000000.0, m.total_ns / 1000.0 / m.calls,
+					get_percentile(m, 50) / 1000.0, get_percentile(m, 99) / 1000.0,
+					record.inst ? "CSC" : "GSC", record.method ? "self " : "", gsc_funcs::lookup_hash(record.inst, "function", record.canon_id)));
+			}
+		}
+	}
+
+	void* wrap(game::scriptInstance_t inst, uint32_t canon_id, bool method, void* func)
+	{
+		if (!enabled || !func)
+		{
+			return func;
+		}
+
+		std::lock_guard _(records_mutex);
+
+		record_key key{ inst, method, canon_id };
+		auto it = records_by_key.find(key);
+
+		if (it != records_by_key.end())
+		{
+			// a name resolved to another function isn't tracked
+			return it->second->func == func ? it->second->stub : func;
+		}
+
+		if (records.size() >= max_builtins)
+		{
+			return func; // too many builtins, the others aren't tracked
+		}
+
+		builtin_record& record = records.emplace_back(builtin_record{ canon_id, inst, method, func, nullptr, records.size() });
+
+		// pass the record as third parameter, the first two are kept for the builtin
+		record.stub = utilities::hook::assemble([&record](utilities::hook::assembler& a)
+			{
+				a.mov(r8, reinterpret_cast<size_t>(&record));
+				a.jmp(reinterpret_cast<size_t>(&call_builtin));
+			}
+		);
+
+		records_by_key[key] = &record;
+		records_by_stub[record.stub] = &record;
+
+		return record.stub;
+	}
+
+	void* unwrap(void* func)
+	{
+		if (!enabled)
+		{
+			return func;
+		}
+
+		std::lock_guard _(records_mutex);
+
+		auto it = records_by_stub.find(func);
+
+		if (it == records_by_stub.end())
+		{
+			return func;
+		}
+
+		return it->second->func;
+	}
+
+	class component final : public component_interface
+	{
+	public:
+		void pre_start() override
+		{
+			// the builtins are wrapped when the scripts are linked, this can't be changed at runtime
+			enabled = utilities::json_config::ReadBoolean("gsc", "builtin_stats", false);
+		}
+
+		void post_unpack() override
+		{
+			command::add("gsc_builtin_stats", builtin_stats_f, "Dump the GSC/CSC builtin call stats, usage: gsc_builtin_stats [count|reset]");
+		}
+	};
+}
+
+REGISTER_COMPONENT(builtin_stats::component)
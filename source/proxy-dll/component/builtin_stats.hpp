@@ -0,0 +1,10 @@
+#pragma once
+#include "definitions/game.hpp"
+
+namespace builtin_stats
+{
+	// returns an instrumented stub calling func when the builtin stats are enabled, func otherwise
+	void* wrap(game::scriptInstance_t inst, uint32_t canon_id, bool method, void* func);
+	// returns the builtin behind an instrumented stub
+	void* unwrap(void* func);
+}
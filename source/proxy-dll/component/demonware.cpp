@@ -11,6 +11,7 @@
 #include "demonware/servers/umbrella_server.hpp"
 #include "demonware/servers/fileshare_server.hpp"
 #include "demonware/server_registry.hpp"
+#include "demonware/socket_table.hpp"
 
 #define TCP_BLOCKING true
 #define UDP_BLOCKING false
@@ -32,24 +33,16 @@ namespace demonware
 	{
 		std::atomic_bool exit_server{ false };
 		std::thread server_thread{};
-		utilities::concurrency::container<std::unordered_map<SOCKET, bool>> blocking_sockets{};
-		utilities::concurrency::container<std::unordered_map<SOCKET, tcp_server*>> socket_map{};
+		socket_table<bool> blocking_sockets{};
+		socket_table<tcp_server*> socket_map{};
+		socket_table<udp_server::out_queue*> udp_socket_map{};
 		server_registry<tcp_server> tcp_servers{};
 		server_registry<udp_server> udp_servers{};
 		std::unordered_map<void*, void*> original_imports{};
 
 		tcp_server* find_server(const SOCKET socket)
 		{
-			return socket_map.access<tcp_server*>([&](const std::unordered_map<SOCKET, tcp_server*>& map) -> tcp_server*
-				{
-					const auto entry = map.find(socket);
-					if (entry == map.end())
-					{
-						return nullptr;
-					}
-
-					return entry->second;
-				});
+			return socket_map.find(socket, nullptr);
 		}
 
 		bool socket_link(const SOCKET socket, const uint32_t address)
@@ -60,58 +53,77 @@ namespace demonware
 				return false;
 			}
 
-			socket_map.access([&](std::unordered_map<SOCKET, tcp_server*>& map)
-				{
-					map[socket] = server;
-				});
-
+			socket_map.insert(socket, server);
 			return true;
 		}
 
 		void socket_unlink(const SOCKET socket)
 		{
-			socket_map.access([&](std::unordered_map<SOCKET, tcp_server*>& map)
-				{
-					const auto entry = map.find(socket);
-					if (entry != map.end())
-					{
-						map.erase(entry);
-					}
-				});
+			socket_map.remove(socket);
 		}
 
 		bool is_socket_blocking(const SOCKET socket, const bool def)
 		{
-			return blocking_sockets.access<bool>([&](std::unordered_map<SOCKET, bool>& map)
-				{
-					const auto entry = map.find(socket);
-					if (entry == map.end())
-					{
-						return def;
-					}
-
-					return entry->second;
-				});
+			return blocking_sockets.find(socket, def);
 		}
 
 		void remove_blocking_socket(const SOCKET socket)
 		{
-			blocking_sockets.access([&](std::unordered_map<SOCKET, bool>& map)
-				{
-					const auto entry = map.find(socket);
-					if (entry != map.end())
-					{
-						map.erase(entry);
-					}
-				});
+			blocking_sockets.remove(socket);
 		}
 
 		void add_blocking_socket(const SOCKET socket, const bool block)
 		{
-			blocking_sockets.access([&](std::unordered_map<SOCKET, bool>& map)
+			blocking_sockets.insert(socket, block);
+		}
+
+		// moves the sockets backed by an emulated server out of set, returns the servers involved
+		uint64_t extract_emulated_sockets(fd_set* set, fd_set* emulated)
+		{
+			emulated->fd_count = 0;
+			if (!set)
+			{
+				return 0;
+			}
+
+			uint64_t servers = 0;
+			u_int count = 0;
+
+			for (u_int i = 0; i < set->fd_count; ++i)
+			{
+				const auto socket = set->fd_array[i];
+				auto* server = find_server(socket);
+
+				if (server)
+				{
+					emulated->fd_array[emulated->fd_count++] = socket;
+					servers |= server->get_readiness_bit();
+				}
+				else
+				{
+					set->fd_array[count++] = socket;
+				}
+			}
+
+			set->fd_count = count;
+			return servers;
+		}
+
+		u_int get_ready_sockets(const fd_set& emulated, fd_set* ready)
+		{
+			const auto ready_servers = tcp_server::get_ready_servers();
+			ready->fd_count = 0;
+
+			for (u_int i = 0; i < emulated.fd_count; ++i)
+			{
+				auto* server = find_server(emulated.fd_array[i]);
+				if (server && (ready_servers & server->get_readiness_bit()))
 				{
-					map[socket] = block;
-				});
+					ready->fd_array[ready->fd_count++] = emulated.fd_array[i];
+				}
+			}
+
+			return ready->fd_count;
 		}
 
 		void server_main()
@@ -273,6 +285,12 @@ namespace demonware
 				remove_blocking_socket(s);
 				socket_unlink(s);
 
+				if (udp_socket_map.find(s, nullptr))
+				{
+					udp_socket_map.remove(s);
+					udp_server::release_out_queue(s);
+				}
+
 				return closesocket(s);
 			}
 
@@ -317,6 +335,11 @@ namespace demonware
 
 				if (server)
 				{
+					if (!udp_socket_map.find(s, nullptr))
+					{
+						udp_socket_map.insert(s, udp_server::get_out_queue(s));
+					}
+
 					server->handle_input(buf, len, { s, to, tolen });
 					return len;
 				}
@@ -333,19 +356,13 @@ namespace demonware
 					return recvfrom(s, buf, len, flags, from, fromlen);
 				}
 
-				size_t result = 0;
-				udp_servers.for_each([&](udp_server& server)
-					{
-						if (server.pending_data(s))
-						{
-							result = server.handle_output(
-								s, buf, static_cast<size_t>(len), from, fromlen);
-						}
-					});
-
-				if (result)
+				if (auto* queue = udp_socket_map.find(s, nullptr))
 				{
-					return static_cast<int>(result);
+					const auto result = udp_server::handle_output(*queue, buf, static_cast<size_t>(len), from, fromlen);
+					if (result)
+					{
+						return static_cast<int>(result);
+					}
 				}
 
 				return recvfrom(s, buf, len, flags, from, fromlen);
@@ -359,68 +376,55 @@ namespace demonware
 					return select(nfds, readfds, writefds, exceptfds, timeout);
 				}
 
+				fd_set emulated_read, emulated_write, emulated_except;
+				const auto read_servers = extract_emulated_sockets(readfds, &emulated_read);
+				extract_emulated_sockets(writefds, &emulated_write);
+				extract_emulated_sockets(exceptfds, &emulated_except); // emulated sockets never report errors
+
+				fd_set read_ready;
+				auto emulated_ready = get_ready_sockets(emulated_read, &read_ready) + emulated_write.fd_count;
+
+				const auto real_sockets = (readfds ? readfds->fd_count : 0)
+					+ (writefds ? writefds->fd_count : 0)
+					+ (exceptfds ? exceptfds->fd_count : 0);
+
 				auto result = 0;
-				std::vector<SOCKET> read_sockets;
-				std::vector<SOCKET> write_sockets;
 
-				socket_map.access([&](std::unordered_map<SOCKET, tcp_server*>& sockets)
-					{
-						for (auto& s : sockets)
-						{
-							if (readfds)
-							{
-								if (FD_ISSET(s.first, readfds))
-								{
-									if (s.second->pending_data())
-									{
-										read_sockets.push_back(s.first);
-										FD_CLR(s.first, readfds);
-									}
-								}
-							}
-
-							if (writefds)
-							{
-								if (FD_ISSET(s.first, writefds))
-								{
-									write_sockets.push_back(s.first);
-									FD_CLR(s.first, writefds);
-								}
-							}
-
-							if (exceptfds)
-							{
-								if (FD_ISSET(s.first, exceptfds))
-								{
-									FD_CLR(s.first, exceptfds);
-								}
-							}
-						}
-					});
-
-				if ((!readfds || readfds->fd_count == 0) && (!writefds || writefds->fd_count == 0))
+				if (real_sockets)
 				{
-					timeout->tv_sec = 0;
-					timeout->tv_usec = 0;
+					// don't hold back emulated sockets that are already ready
+					timeval no_wait{};
+					result = select(nfds, readfds, writefds, exceptfds, emulated_ready ? &no_wait : timeout);
+					if (result < 0) result = 0;
 				}
+				else if (!emulated_ready && read_servers)
+				{
+					std::optional<std::chrono::microseconds> wait_time{};
+					if (timeout)
+					{
+						wait_time = std::chrono::seconds(timeout->tv_sec) + std::chrono::microseconds(timeout->tv_usec);
+					}
 
-				result = select(nfds, readfds, writefds, exceptfds, timeout);
-				if (result < 0) result = 0;
+					if (tcp_server::wait_for_ready_servers(read_servers, wait_time))
+					{
+						emulated_ready = get_ready_sockets(emulated_read, &read_ready);
+					}
+				}
 
-				for (const auto& socket : read_sockets)
+				if (readfds)
 				{
-					if (readfds)
+					for (u_int i = 0; i < read_ready.fd_count; ++i)
 					{
-						FD_SET(socket, readfds);
+						FD_SET(read_ready.fd_array[i], readfds);
 						result++;
 					}
 				}
 
-				for (const auto& socket : write_sockets)
+				if (writefds)
 				{
-					if (writefds)
+					for (u_int i = 0; i < emulated_write.fd_count; ++i)
 					{
-						FD_SET(socket, writefds);
+						FD_SET(emulated_write.fd_array[i], writefds);
 						result++;
 					}
 				}
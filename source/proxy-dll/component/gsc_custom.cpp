@@ -1,6 +1,7 @@
 #include <std_include.hpp>
 #include "gsc_custom.hpp"
 #include "gsc_funcs.hpp"
+#include "gsc_saves.hpp"
 #include "hashes.hpp"
 #include "definitions/game.hpp"
 #include "definitions/xassets.hpp"
@@ -25,155 +26,734 @@ namespace gsc_custom
 			return reinterpret_cast<byte*>((reinterpret_cast<uintptr_t>(ptr) + sizeof(T) - 1) & ~(sizeof(T) - 1));
 		}
 
+		struct export_key
+		{
+			uint64_t script;
+			uint32_t name_space;
+			uint32_t name;
+
+			bool operator==(const export_key& other) const = default;
+		};
+
+		struct export_key_hash
+		{
+			size_t operator()(const export_key& key) const
+			{
+				return std::hash<uint64_t>{}(key.script ^ ((static_cast<uint64_t>(key.name_space) << 32 | key.name) * 0x9E3779B97F4A7C15));
+			}
+		};
+
+		struct indexed_export
+		{
+			byte* address;
+			const game::GSC_EXPORT_ITEM* item;
+		};
+
+		struct code_export
+		{
+			uint32_t address;
+			const game::GSC_EXPORT_ITEM* item;
+		};
+
+		// code segment of a linked script, with its exports sorted by address
+		struct code_range
+		{
+			const byte* start;
+			const byte* end;
+			game::GSC_OBJ* obj;
+			std::shared_ptr<const std::vector<code_export>> exports;
+		};
+
+		using code_ranges = std::vector<code_range>;
+
+		// exports of the linked scripts, filled as the script groups are linked
+		struct script_index
+		{
+			uint32_t indexed_count{};
+			std::unordered_map<uint64_t, game::GSC_OBJ*> scripts{};
+			std::unordered_map<export_key, indexed_export, export_key_hash> exports{};
+			code_ranges ranges{};
+		};
+
+		struct indexed_detour
+		{
+			const gsic_detour* detour;
+			size_t data_index;
+		};
+
 		std::vector<gsic_link_detour_data> gsic_data[game::SCRIPTINSTANCE_MAX]{ {}, {} };
+		std::unordered_map<export_key, indexed_detour, export_key_hash> detour_index[game::SCRIPTINSTANCE_MAX]{};
+		// target scripts of the detours, to skip the scripts that can't be detoured
+		std::unordered_set<uint64_t> detour_scripts[game::SCRIPTINSTANCE_MAX]{};
+		script_index script_indexes[game::SCRIPTINSTANCE_MAX]{};
+		// sorted copy of the code ranges published for the readers, they don't take the scripts lock
+		std::atomic<std::shared_ptr<const code_ranges>> code_indexes[game::SCRIPTINSTANCE_MAX]{};
+		// scripts covered by the published ranges, stored after them
+		std::atomic<uint32_t> code_indexed_counts[game::SCRIPTINSTANCE_MAX]{};
+
+		// resolved lazylink call sites, anything that can change a resolution bumps the
+		// instance generation so every older entry reads as a miss
+		struct lazylink_cache_entry
+		{
+			const byte* site{};
+			uint32_t generation{};
+			bool dev_func{};
+			game::ScrVarValue_t value{};
+		};
+
+		constexpr size_t lazylink_cache_size = 0x1000;
+
+		std::array<lazylink_cache_entry, lazylink_cache_size> lazylink_cache[game::SCRIPTINSTANCE_MAX]{};
+		uint32_t link_generation[game::SCRIPTINSTANCE_MAX]{ 1, 1 };
 
-		byte* find_export(game::scriptInstance_t inst, uint64_t target_script, uint32_t name_space, uint32_t name)
+		void invalidate_links(game::scriptInstance_t inst)
 		{
-			uint32_t count = game::gObjFileInfoCount[inst];
+			link_generation[inst]++;
+		}
+
+		lazylink_cache_entry& get_lazylink_cache_entry(game::scriptInstance_t inst, const byte* site)
+		{
+			// sites are 4 bytes aligned
+			return lazylink_cache[inst][(reinterpret_cast<uintptr_t>(site) >> 2) & (lazylink_cache_size - 1)];
+		}
+
+		void clear_script_index(game::scriptInstance_t inst)
+		{
+			script_index& index = script_indexes[inst];
+
+			index.indexed_count = 0;
+			index.scripts.clear();
+			index.exports.clear();
+			index.ranges.clear();
+
+			code_indexed_counts[inst].store(0, std::memory_order_release);
+			code_indexes[inst].store(nullptr, std::memory_order_release);
+		}
+
+		code_range make_code_range(game::GSC_OBJ* obj)
+		{
+			auto exports = std::make_shared<std::vector<code_export>>();
+			exports->reserve(obj->exports_count);
+
+			for (const game::GSC_EXPORT_ITEM* exp = obj->get_exports(); exp != obj->get_exports_end(); exp++)
+			{
+				exports->emplace_back(code_export{ exp->address, exp });
+			}
 
-			game::objFileInfo_t* end = (*game::gObjFileInfo)[inst] + count;
+			std::stable_sort(exports->begin(), exports->end(), [](const code_export& a, const code_export& b) { return a.address < b.address; });
 
-			auto its = std::find_if((*game::gObjFileInfo)[inst], end,
-				[target_script](const game::objFileInfo_t& info) { return info.activeVersion->name == target_script; });
+			return code_range{ obj->magic + obj->cseg_offset, obj->magic + obj->cseg_offset + obj->cseg_size, obj, std::move(exports) };
+		}
 
-			if (its == end)
+		void update_script_index(game::scriptInstance_t inst)
+		{
+			script_index& index = script_indexes[inst];
+			uint32_t count = game::gObjFileInfoCount[inst];
+
+			if (count < index.indexed_count)
 			{
-				return nullptr; // can't find target script
+				// the scripts were unloaded since the last link
+				clear_script_index(inst);
 			}
 
-			game::GSC_OBJ* obj = its->activeVersion;
+			size_t first_range = index.ranges.size();
+
+			for (; index.indexed_count < count; index.indexed_count++)
+			{
+				game::GSC_OBJ* obj = (*game::gObjFileInfo)[inst][index.indexed_count].activeVersion;
+
+				if (!obj)
+				{
+					continue;
+				}
+
+				index.ranges.emplace_back(make_code_range(obj));
+
+				if (!index.scripts.emplace(obj->name, obj).second)
+				{
+					continue; // the first linked version is the one used
+				}
 
-			auto ite = std::find_if(obj->get_exports(), obj->get_exports_end(), 
-				[name_space, name](const game::GSC_EXPORT_ITEM& exp) { return exp.name == name && exp.name_space == name_space; });
+				for (const game::GSC_EXPORT_ITEM* exp = obj->get_exports(); exp != obj->get_exports_end(); exp++)
+				{
+					index.exports.emplace(export_key{ obj->name, exp->name_space, exp->name }, indexed_export{ obj->magic + exp->address, exp });
+				}
+			}
 
-			if (ite == obj->get_exports_end())
+			if (first_range != index.ranges.size())
 			{
-				return nullptr; // can't find target export
+				auto by_start = [](const code_range& a, const code_range& b) { return a.start < b.start; };
+				auto middle = index.ranges.begin() + first_range;
+
+				std::stable_sort(middle, index.ranges.end(), by_start);
+				std::inplace_merge(index.ranges.begin(), middle, index.ranges.end(), by_start);
+
+				code_indexes[inst].store(std::make_shared<const code_ranges>(index.ranges), std::memory_order_release);
 			}
 
-			return obj->magic + ite->address;
+			code_indexed_counts[inst].store(index.indexed_count, std::memory_order_release);
 		}
 
-		byte* find_detour(game::scriptInstance_t inst, byte* origin, uint64_t target_script, uint32_t name_space, uint32_t name)
+		// the group being linked is indexed after its autoexecs, they are found by scanning the loaded scripts
+		game::GSC_OBJ* find_unindexed_code_script(game::scriptInstance_t inst, uint32_t first, const byte* codepos, const game::GSC_EXPORT_ITEM** export_item)
 		{
-			for (const gsic_link_detour_data& data : gsic_data[inst])
+			game::scoped_critical_section scs{ 0x36, game::SCOPED_CRITSECT_NORMAL };
+
+			uint32_t count = game::gObjFileInfoCount[inst];
+
+			for (uint32_t i = first; i < count; i++)
 			{
-				for (const gsic_detour& detour : data.gsic_info.detours)
+				game::GSC_OBJ* obj = (*game::gObjFileInfo)[inst][i].activeVersion;
+
+				if (!obj || codepos < obj->magic + obj->cseg_offset || codepos >= obj->magic + obj->cseg_offset + obj->cseg_size)
 				{
-					if (detour.target_script != target_script || name_space != detour.replace_namespace || name != detour.replace_function)
-					{
-						continue; // not our target
-					}
-					if (detour.fixup_function <= origin && detour.fixup_function + detour.fixup_offset > origin)
+					continue;
+				}
+
+				if (export_item)
+				{
+					// closest export before the position
+					uint32_t rloc = (uint32_t)(codepos - obj->magic);
+
+					for (const game::GSC_EXPORT_ITEM* exp = obj->get_exports(); exp != obj->get_exports_end(); exp++)
 					{
-						continue; // inside the detour
+						if (rloc >= exp->address && (!*export_item || (*export_item)->address <= exp->address))
+						{
+							*export_item = exp;
+						}
 					}
-					return detour.fixup_function;
 				}
+
+				return obj;
 			}
 
 			return nullptr;
 		}
 
+		const indexed_export* find_indexed_export(const script_index& index, uint64_t target_script, uint32_t name_space, uint32_t name)
+		{
+			auto it = index.exports.find(export_key{ target_script, name_space, name });
+
+			if (it == index.exports.end())
+			{
+				return nullptr;
+			}
+
+			return &it->second;
+		}
+
+		const indexed_export* find_indexed_export(game::scriptInstance_t inst, uint64_t target_script, uint32_t name_space, uint32_t name)
+		{
+			update_script_index(inst);
+
+			return find_indexed_export(script_indexes[inst], target_script, name_space, name);
+		}
+
+		byte* find_detour(game::scriptInstance_t inst, byte* origin, uint64_t target_script, uint32_t name_space, uint32_t name)
+		{
+			auto& detours = detour_index[inst];
+			auto it = detours.find(export_key{ target_script, name_space, name });
+
+			if (it == detours.end())
+			{
+				return nullptr; // not detoured
+			}
+
+			const gsic_detour& detour = *it->second.detour;
+
+			if (detour.fixup_function <= origin && detour.fixup_function + detour.fixup_offset > origin)
+			{
+				return nullptr; // inside the detour
+			}
+
+			return detour.fixup_function;
+		}
+
+		// scripts with detours a script can use, a detour can only replace functions from the script itself or from its includes
+		void find_detoured_scripts(game::scriptInstance_t inst, game::GSC_OBJ* obj, std::vector<uint64_t>& scripts)
+		{
+			auto& targets = detour_scripts[inst];
+
+			scripts.clear();
+
+			if (targets.contains(obj->name))
+			{
+				scripts.emplace_back(obj->name);
+			}
+
+			for (const uint64_t* include = obj->get_includes(); include != obj->get_includes_end(); include++)
+			{
+				if (targets.contains(*include))
+				{
+					scripts.emplace_back(*include);
+				}
+			}
+		}
+
+		const indexed_detour* find_import_detour(game::scriptInstance_t inst, const std::vector<uint64_t>& scripts, const game::GSC_IMPORT_ITEM* import_item)
+		{
+			auto& detours = detour_index[inst];
+
+			for (uint64_t script : scripts)
+			{
+				auto it = detours.find(export_key{ script, import_item->name_space, import_item->name });
+
+				if (it != detours.end())
+				{
+					return &it->second;
+				}
+			}
+
+			return nullptr;
+		}
+
+		// doesn't update the index, it can be read by several threads
+		bool is_import_available(const script_index& index, game::GSC_OBJ* obj, const game::GSC_IMPORT_ITEM* import_item)
+		{
+			if (find_indexed_export(index, obj->name, import_item->name_space, import_item->name))
+			{
+				return true; // own export
+			}
+
+			for (const uint64_t* include = obj->get_includes(); include != obj->get_includes_end(); include++)
+			{
+				const indexed_export* exp = find_indexed_export(index, *include, import_item->name_space, import_item->name);
+
+				// can't import private exports
+				if (exp && !(exp->item->flags & game::GSC_EXPORT_FLAGS::GEF_PRIVATE))
+				{
+					return true;
+				}
+			}
+
+			return false;
+		}
 
 		void clear_gsic(game::scriptInstance_t inst)
 		{
 			// clear previously register GSIC
 			gsic_data[inst].clear();
+			detour_index[inst].clear();
+			detour_scripts[inst].clear();
+			invalidate_links(inst);
+		}
+
+		bool link_detour(game::GSC_OBJ* obj, game::GSC_IMPORT_ITEM* import_item, const gsic_detour& detour)
+		{
+			uint32_t* addresses = reinterpret_cast<uint32_t*>(import_item + 1);
+
+			// replace the linking
+
+			// see GscObjResolve(scriptInstance_t, GSC_OBJ*)0x142746A30_g for info
+
+			int offset;
+			switch (import_item->flags & 0xF)
+			{
+			case 1: // &namespace::function
+			{
+				offset = 0; // only function/method calls are using params
+			}
+			break;
+			case 2: // func()
+			case 3: // thread func()
+			case 4: // childthread func()
+			case 5: // self method()
+			case 6: // self thread method()
+			case 7: // self childthread method()
+			{
+				offset = 1;
+			}
+			break;
+			default:
+				logger::write(logger::LOG_TYPE_ERROR, std::format("can't link import item with flag {:x}", import_item->flags & 0xF));
+				assert(false); // if the game didn't crash before this point it's impressive
+				return false;
+			}
+
+			for (size_t j = 0; j < import_item->num_address; j++)
+			{
+				// opcode loc
+				byte* loc = align_ptr<uint16_t>(obj->magic + addresses[j]);
+
+				if (loc >= detour.fixup_function && loc < detour.fixup_function + detour.fixup_size)
+				{
+					continue; // this import is inside the detour definition, we do not replace it
+				}
+
+				// align for ptr
+				byte** ptr_loc = (byte**)align_ptr<uintptr_t>(loc + 2 + offset);
+#ifdef _DEBUG_DETOUR
+				logger::write(logger::LOG_TYPE_DEBUG, 
+					std::format(
+						"linking detours for namespace_{:x}<script_{:x}>::function_{:x} at {} : {} -> {} (0x{:x})",
+						detour.replace_namespace, obj->name, detour.replace_function, 
+						(void*)ptr_loc,
+						(void*)(*ptr_loc),
+						(void*)(detour.fixup_function), *(uint64_t*)detour.fixup_function)
+				);
+#endif
+
+				// TODO: replace opcode for api function detours
+				//uint16_t* opcode_loc = (uint16_t*)loc;
+
+				*ptr_loc = detour.fixup_function;
+			}
+
+			return true;
 		}
 
 		void link_detours(game::scriptInstance_t inst)
 		{
 			// link the GSIC detours
 
-			for (gsic_link_detour_data& data : gsic_data[inst])
+			auto& inst_data = gsic_data[inst];
+			uint32_t count = game::gObjFileInfoCount[inst];
+
+			if (inst_data.empty())
+			{
+				return; // nothing to link
+			}
+
+			// scripts already linked by every GSIC file can be skipped
+			uint32_t first_script_index = count;
+
+			for (const gsic_link_detour_data& data : inst_data)
+			{
+				first_script_index = std::min(first_script_index, data.latest_script_index);
+			}
+
+			std::vector<uint64_t> scripts{};
+
+			for (uint32_t obj_index = first_script_index; obj_index < count; obj_index++)
 			{
-				for (; data.latest_script_index < game::gObjFileInfoCount[inst]; data.latest_script_index++)
+				game::GSC_OBJ* obj = (*game::gObjFileInfo)[inst][obj_index].activeVersion;
+
+				find_detoured_scripts(inst, obj, scripts);
+
+				if (scripts.empty())
+				{
+					continue; // nothing detoured in this script or its includes
+				}
+
+				// reading imports
+
+				game::GSC_IMPORT_ITEM* import_item = obj->get_imports();
+
+				for (size_t i = 0; i < obj->imports_count; i++)
+				{
+					uint32_t* addresses = reinterpret_cast<uint32_t*>(import_item + 1);
+
+					const indexed_detour* detour = find_import_detour(inst, scripts, import_item);
+
+					// only link the scripts loaded after the GSIC file
+					if (detour && obj_index >= inst_data[detour->data_index].latest_script_index && !link_detour(obj, import_item, *detour->detour))
+					{
+						return;
+					}
+
+					// goto to the next element after the addresses
+					import_item = reinterpret_cast<game::GSC_IMPORT_ITEM*>(addresses + import_item->num_address);
+				}
+			}
+
+			for (gsic_link_detour_data& data : inst_data)
+			{
+				data.latest_script_index = count;
+			}
+		}
+
+		struct linking_issues
+		{
+			std::vector<uint64_t> missing_usings{};
+			std::vector<game::GSC_IMPORT_ITEM*> unknown_imports{};
+		};
+
+		// exports of the usings that aren't linked, loaded once for all the scripts
+		struct using_index
+		{
+			std::unordered_set<uint64_t> missing{};
+			std::unordered_set<export_key, export_key_hash> exports{};
+		};
+
+		void load_using_index(game::scriptInstance_t inst, using_index& usings)
+		{
+			const script_index& index = script_indexes[inst];
+			std::unordered_set<uint64_t> loaded{};
+
+			for (size_t obj = 0; obj < game::gObjFileInfoCount[inst]; obj++)
+			{
+				game::GSC_OBJ* prime_obj = (*game::gObjFileInfo)[inst][obj].activeVersion;
+
+				if (!prime_obj)
+				{
+					continue;
+				}
+
+				for (const uint64_t* include = prime_obj->get_includes(); include != prime_obj->get_includes_end(); include++)
 				{
-					game::GSC_OBJ* obj = (*game::gObjFileInfo)[inst][data.latest_script_index].activeVersion;
-					// link the detour
-					for (const gsic_detour& detour : data.gsic_info.detours)
+					if (index.scripts.contains(*include) || !loaded.insert(*include).second)
+					{
+						continue;
+					}
+
+					game::BO4_AssetRef_t ref{ (int64_t)*include, 0 };
+					xassets::scriptparsetree_header* spt = xassets::DB_FindXAssetHeader(xassets::ASSET_TYPE_SCRIPTPARSETREE, &ref, false, -1).scriptparsetree;
+
+					if (!spt || !spt->buffer)
 					{
-						if (std::find(obj->get_includes(), obj->get_includes_end(), detour.target_script) == obj->get_includes_end() && obj->name != detour.target_script)
+						usings.missing.insert(*include);
+						continue;
+					}
+
+					for (const game::GSC_EXPORT_ITEM* exp = spt->buffer->get_exports(); exp != spt->buffer->get_exports_end(); exp++)
+					{
+						if (exp->flags & game::GSC_EXPORT_FLAGS::GEF_PRIVATE)
 						{
-							continue; // the target script isn't in the includes, so we have nothing to link
+							continue; // can't import private exports
 						}
+						usings.exports.insert(export_key{ *include, exp->name_space, exp->name });
+					}
+				}
+			}
+		}
 
-						// reading imports
+		// only reads the indexes, called by the worker threads
+		void find_script_linking_issues(const script_index& index, const using_index& usings, game::GSC_OBJ* prime_obj, linking_issues& issues)
+		{
+			std::vector<uint64_t> unlinked{};
 
-						game::GSC_IMPORT_ITEM* import_item = obj->get_imports();
+			for (const uint64_t* include = prime_obj->get_includes(); include != prime_obj->get_includes_end(); include++)
+			{
+				if (index.scripts.contains(*include))
+				{
+					continue;
+				}
 
-						for (size_t i = 0; i < obj->imports_count; i++)
-						{
-							uint32_t* addresses = reinterpret_cast<uint32_t*>(import_item + 1);
-
-							if (import_item->name_space == detour.replace_namespace && import_item->name == detour.replace_function)
-							{
-								// replace the linking
-
-								// see GscObjResolve(scriptInstance_t, GSC_OBJ*)0x142746A30_g for info
-
-								int offset;
-								switch (import_item->flags & 0xF)
-								{
-								case 1: // &namespace::function
-								{
-									offset = 0; // only function/method calls are using params
-								}
-								break;
-								case 2: // func()
-								case 3: // thread func()
-								case 4: // childthread func()
-								case 5: // self method()
-								case 6: // self thread method()
-								case 7: // self childthread method()
-								{
-									offset = 1;
-								}
-								break;
-								default:
-									logger::write(logger::LOG_TYPE_ERROR, std::format("can't link import item with flag {:x}", import_item->flags & 0xF));
-									assert(false); // if the game didn't crash before this point it's impressive
-									return;
-								}
-
-								for (size_t j = 0; j < import_item->num_address; j++)
-								{
-									// opcode loc
-									byte* loc = align_ptr<uint16_t>(obj->magic + addresses[j]);
-
-									if (loc >= detour.fixup_function && loc < detour.fixup_function + detour.fixup_size)
-									{
-										continue; // this import is inside the detour definition, we do not replace it
-									}
-
-									// align for ptr
-									byte** ptr_loc = (byte**)align_ptr<uintptr_t>(loc + 2 + offset);
-#ifdef _DEBUG_DETOUR
-									logger::write(logger::LOG_TYPE_DEBUG, 
-										std::format(
-											"linking detours for namespace_{:x}<script_{:x}>::function_{:x} at {} : {} -> {} (0x{:x})",
-											detour.replace_namespace, obj->name, detour.replace_function, 
-											(void*)ptr_loc,
-											(void*)(*ptr_loc),
-											(void*)(detour.fixup_function), *(uint64_t*)detour.fixup_function)
-									);
-#endif
+				if (usings.missing.contains(*include))
+				{
+					issues.missing_usings.emplace_back(*include);
+				}
+				else
+				{
+					unlinked.emplace_back(*include);
+				}
+			}
+
+			game::GSC_IMPORT_ITEM* imports = prime_obj->get_imports();
+
+			for (size_t i = 0; i < prime_obj->imports_count; i++)
+			{
+				game::GSC_IMPORT_ITEM* imp = imports;
 
-									// TODO: replace opcode for api function detours
-									//uint16_t* opcode_loc = (uint16_t*)loc;
+				uint32_t* locations = reinterpret_cast<uint32_t*>(imp + 1);
+				imports = reinterpret_cast<game::GSC_IMPORT_ITEM*>(locations + imp->num_address);
+
+				if (imp->flags & game::GSC_IMPORT_FLAGS::GIF_DEV_CALL)
+				{
+					// ignore dev calls
+					continue;
+				}
+
+				if (is_import_available(index, prime_obj, imp))
+				{
+					continue;
+				}
+
+				if (std::any_of(unlinked.begin(), unlinked.end(), [&usings, imp](uint64_t include) { return usings.exports.contains(export_key{ include, imp->name_space, imp->name }); }))
+				{
+					continue;
+				}
+
+				issues.unknown_imports.emplace_back(imp);
+			}
+		}
+
+		void report_unknown_import(game::scriptInstance_t inst, game::GSC_OBJ* prime_obj, game::GSC_IMPORT_ITEM* imp)
+		{
+			uint32_t* locations = reinterpret_cast<uint32_t*>(imp + 1);
 
-									*ptr_loc = detour.fixup_function;
-								}
-							}
+			byte import_type = imp->flags & game::GSC_IMPORT_FLAGS::GIF_CALLTYPE_MASK;
 
-							// goto to the next element after the addresses
-							import_item = reinterpret_cast<game::GSC_IMPORT_ITEM*>(addresses + import_item->num_address);
+			// search builtin calls
+			if ((imp->flags & game::GSC_IMPORT_FLAGS::GIF_GET_CALL) != 0 || imp->name_space == 0xC1243180 || imp->name_space == 0x222276A9)
+			{
+
+				int type{};
+				int ignored{};
+				if (import_type == game::GSC_IMPORT_FLAGS::GIF_FUNC_METHOD || import_type == game::GSC_IMPORT_FLAGS::GIF_FUNCTION)
+				{
+					// &func or func()
+					if (inst)
+					{
+						if (game::CScr_GetFunction(imp->name, &type, &ignored, &ignored) && !type)
+						{
+							return;
+						}
+					}
+					else
+					{
+						if (game::Scr_GetFunction(imp->name, &type, &ignored, &ignored) && !type)
+						{
+							return;
+						}
+					}
+				}
+
+				if (import_type == game::GSC_IMPORT_FLAGS::GIF_FUNC_METHOD || import_type == game::GSC_IMPORT_FLAGS::GIF_METHOD)
+				{
+					// &meth or <x> meth()
+					if (inst)
+					{
+						if (game::CScr_GetMethod(imp->name, &type, &ignored, &ignored) && !type)
+						{
+							return;
+						}
+					}
+					else
+					{
+						if (game::Scr_GetMethod(imp->name, &type, &ignored, &ignored) && !type)
+						{
+							return;
 						}
 					}
 				}
 			}
+
+			const char* func;
+
+			if ((imp->flags & game::GSC_IMPORT_FLAGS::GIF_GET_CALL) != 0 || imp->name_space == 0xC1243180 || imp->name_space == 0x222276A9)
+			{
+				func = hashes::lookup_tmp("function", imp->name);
+			}
+			else
+			{
+				func = utilities::string::va("%s::%s", hashes::lookup_tmp("namespace", imp->name_space), hashes::lookup_tmp("function", imp->name));
+			}
+
+			const char* prefix;
+
+			switch (import_type)
+			{
+			case game::GIF_FUNC_METHOD:
+				prefix = "&";
+				break;
+			case game::GIF_FUNCTION:
+			case game::GIF_METHOD:
+				prefix = "";
+				break;
+			case game::GIF_FUNCTION_THREAD:
+			case game::GIF_METHOD_THREAD:
+				prefix = "thread ";
+				break;
+			case game::GIF_FUNCTION_CHILDTHREAD:
+			case game::GIF_METHOD_CHILDTHREAD:
+				prefix = "childthread ";
+				break;
+			default:
+				prefix = "<error>";
+				break;
+			}
+
+			logger::write(logger::LOG_TYPE_ERROR, "[%s] Unknown import %s%s in %s",
+				inst ? "CSC" : "GSC", prefix, func, hashes::lookup_tmp("script", prime_obj->name)
+			);
+			for (size_t j = 0; j < imp->num_address; j++)
+			{
+				const char* scriptname{};
+				int32_t sloc{};
+				int32_t crc{};
+				int32_t vm{};
+				game::Scr_GetGscExportInfo(inst, prime_obj->magic + locations[j], &scriptname, &sloc, &crc, &vm);
+				if (scriptname)
+				{
+					logger::write(logger::LOG_TYPE_ERROR, "[%s] at %s", inst ? "CSC" : "GSC", scriptname);
+				}
+				else
+				{
+					logger::write(logger::LOG_TYPE_ERROR, "[%s] at %s@%lx", inst ? "CSC" : "GSC", hashes::lookup_tmp("script", prime_obj->name), locations[j]);
+				}
+			}
+		}
+	}
+
+	byte* find_export(game::scriptInstance_t inst, uint64_t target_script, uint32_t name_space, uint32_t name)
+	{
+		const indexed_export* exp = find_indexed_export(inst, target_script, name_space, name);
+
+		if (!exp)
+		{
+			return nullptr; // can't find target export
+		}
+
+		return exp->address;
+	}
+
+	game::GSC_OBJ* find_script(game::scriptInstance_t inst, uint64_t script)
+	{
+		update_script_index(inst);
+
+		auto& scripts = script_indexes[inst].scripts;
+		auto it = scripts.find(script);
+
+		if (it == scripts.end())
+		{
+			return nullptr;
+		}
+
+		return it->second;
+	}
+
+	game::GSC_OBJ* find_code_script(game::scriptInstance_t inst, const byte* codepos, const game::GSC_EXPORT_ITEM** export_item)
+	{
+		if (export_item)
+		{
+			*export_item = nullptr;
+		}
+
+		if (!game::gObjFileInfoCount[inst])
+		{
+			return nullptr; // the scripts were unloaded
+		}
+
+		// the count is loaded first, the ranges cover at least these scripts
+		uint32_t indexed_count = code_indexed_counts[inst].load(std::memory_order_acquire);
+		const auto ranges = code_indexes[inst].load(std::memory_order_acquire);
+
+		const code_range* range = nullptr;
+
+		if (ranges)
+		{
+			auto it = std::upper_bound(ranges->begin(), ranges->end(), codepos, [](const byte* pos, const code_range& range) { return pos < range.start; });
+
+			if (it != ranges->begin() && codepos < std::prev(it)->end)
+			{
+				range = &*std::prev(it);
+			}
+		}
+
+		if (!range)
+		{
+			if (game::gObjFileInfoCount[inst] <= indexed_count)
+			{
+				return nullptr; // not in a script code segment
+			}
+
+			return find_unindexed_code_script(inst, indexed_count, codepos, export_item);
+		}
+
+		if (export_item)
+		{
+			// closest export before the position
+			uint32_t rloc = (uint32_t)(codepos - range->obj->magic);
+			auto ite = std::upper_bound(range->exports->begin(), range->exports->end(), rloc, [](uint32_t loc, const code_export& exp) { return loc < exp.address; });
+
+			if (ite != range->exports->begin())
+			{
+				*export_item = std::prev(ite)->item;
+			}
 		}
+
+		return range->obj;
 	}
 
 	void sync_gsic(game::scriptInstance_t inst, gsic_info& info)
@@ -187,28 +767,25 @@ namespace gsc_custom
 			return; // already sync
 		}
 
-		for (const gsic_link_detour_data& link_data : inst_data)
+		auto& detours = detour_index[inst];
+
+		for (const gsic_detour& detour : info.detours)
 		{
-			for (const gsic_detour& detour : link_data.gsic_info.detours)
+			if (detours.contains(export_key{ detour.target_script, detour.replace_namespace, detour.replace_function }))
 			{
-				auto it = std::find_if(info.detours.begin(), info.detours.end(),
-					[&detour](const gsic_detour& detour2)
-					{
-						return detour.target_script == detour2.target_script
-							&& detour.replace_function == detour2.replace_function
-							&& detour.replace_namespace == detour2.replace_namespace;
-					}
-				);
-
-				if (it != info.detours.end())
-				{
-					gsc_funcs::gsc_error("the detour namespace_%x<script_%llx>::function_%x was registered twice", inst, true, detour.replace_namespace, detour.target_script, detour.replace_function);
-					return;
-				}
+				gsc_funcs::gsc_error("the detour namespace_%x<script_%llx>::function_%x was registered twice", inst, true, detour.replace_namespace, detour.target_script, detour.replace_function);
+				return;
 			}
 		}
 
+		for (const gsic_detour& detour : info.detours)
+		{
+			detours.emplace(export_key{ detour.target_script, detour.replace_namespace, detour.replace_function }, indexed_detour{ &detour, inst_data.size() });
+			detour_scripts[inst].insert(detour.target_script);
+		}
+
 		inst_data.emplace_back(info);
+		invalidate_links(inst);
 	}
 
 	void vm_op_custom_devblock(game::scriptInstance_t inst, game::function_stack_t* fs_0, game::ScrVmContext_t* vmc, bool* terminate)
@@ -225,15 +802,11 @@ namespace gsc_custom
 	}
 
 
-	void vm_op_custom_lazylink(game::scriptInstance_t inst, game::function_stack_t* fs_0, game::ScrVmContext_t* vmc, bool* terminate)
+	game::ScrVarValue_t resolve_lazylink(game::scriptInstance_t inst, byte* base, uint64_t script, uint32_t name_space, uint32_t name)
 	{
-		byte* base = align_ptr<uint32_t>(fs_0->pos);
-		uint32_t name_space = *(uint32_t*)base;
-		uint32_t name = *(uint32_t*)(base + 4);
-		uint64_t script = *(uint64_t*)(base + 8);
-
-		// pass the data
-		fs_0->pos = base + 0x10;
+		game::ScrVarValue_t result{};
+		result.type = game::TYPE_UNDEFINED;
+		result.u.intValue = 0;
 
 		// find the detour first
 		byte* detour_result = find_detour(inst, base, script, name_space, name);
@@ -241,29 +814,19 @@ namespace gsc_custom
 		if (detour_result)
 		{
 			// push detour function
-			fs_0->top++;
-
-			fs_0->top->type = game::TYPE_SCRIPT_FUNCTION;
-			fs_0->top->u.codePosValue = detour_result;
+			result.type = game::TYPE_SCRIPT_FUNCTION;
+			result.u.codePosValue = detour_result;
 		}
 		else if (script)
 		{
 			// lazy link script function
 			byte* exp = find_export(inst, script, name_space, name);
 
-
 			// push the result or undefined
-			fs_0->top++;
-
 			if (exp)
 			{
-				fs_0->top->type = game::TYPE_SCRIPT_FUNCTION;
-				fs_0->top->u.codePosValue = exp;
-			}
-			else
-			{
-				fs_0->top->type = game::TYPE_UNDEFINED;
-				fs_0->top->u.intValue = 0;
+				result.type = game::TYPE_SCRIPT_FUNCTION;
+				result.u.codePosValue = exp;
 			}
 		}
 		else
@@ -290,203 +853,107 @@ namespace gsc_custom
 				}
 			}
 
-			fs_0->top++;
-
 			if (func && (!type || gsc_funcs::enable_dev_func))
 			{
 				// do not allow dev functions if it is not asked by the user
-				fs_0->top->type = game::TYPE_API_FUNCTION;
-				fs_0->top->u.codePosValue = (byte*)func;
-			}
-			else
-			{
-				fs_0->top->type = game::TYPE_UNDEFINED;
-				fs_0->top->u.intValue = 0;
+				result.type = game::TYPE_API_FUNCTION;
+				result.u.codePosValue = (byte*)func;
 			}
 		}
 
+		return result;
+	}
+
+	void vm_op_custom_lazylink(game::scriptInstance_t inst, game::function_stack_t* fs_0, game::ScrVmContext_t* vmc, bool* terminate)
+	{
+		byte* base = align_ptr<uint32_t>(fs_0->pos);
+
+		// pass the data
+		fs_0->pos = base + 0x10;
+
+		lazylink_cache_entry& entry = get_lazylink_cache_entry(inst, base);
+
+		if (entry.site != base || entry.generation != link_generation[inst] || entry.dev_func != gsc_funcs::enable_dev_func)
+		{
+			uint32_t name_space = *(uint32_t*)base;
+			uint32_t name = *(uint32_t*)(base + 4);
+			uint64_t script = *(uint64_t*)(base + 8);
+
+			entry.value = resolve_lazylink(inst, base, script, name_space, name);
+			entry.site = base;
+			entry.generation = link_generation[inst];
+			entry.dev_func = gsc_funcs::enable_dev_func;
+		}
+
+		fs_0->top++;
+		*fs_0->top = entry.value;
 	}
 
 	void find_linking_issues()
 	{
 		logger::write(logger::LOG_TYPE_ERROR, "Linking error detected, searching cause...");
 
-		std::unordered_map<uint32_t, std::unordered_set<uint32_t>> availables{};
 		for (size_t _inst = 0; _inst < game::SCRIPTINSTANCE_MAX; _inst++)
 		{
 			size_t error{};
 			game::scriptInstance_t inst = (game::scriptInstance_t)_inst;
-			for (size_t obj = 0; obj < game::gObjFileInfoCount[inst]; obj++)
-			{
-				game::objFileInfo_t& info = (*game::gObjFileInfo)[inst][obj];
-
-				if (!info.activeVersion)
-				{
-					continue;
-				}
 
-				game::GSC_OBJ* prime_obj = info.activeVersion;
+			update_script_index(inst);
 
-				availables.clear();
+			uint32_t count = game::gObjFileInfoCount[inst];
+			using_index usings{};
 
-				// load exports
-				game::GSC_EXPORT_ITEM* exports = (game::GSC_EXPORT_ITEM*)(prime_obj->magic + prime_obj->exports_offset);
+			load_using_index(inst, usings);
 
-				for (size_t i = 0; i < prime_obj->exports_count; i++)
-				{
-					availables[exports[i].name_space].insert(exports[i].name);
-				}
+			// the scripts are checked in parallel, the issues are reported in the scripts order after
+			std::vector<linking_issues> issues(count);
+			std::atomic<uint32_t> next_script{};
+			std::vector<std::thread> threads{};
 
-				// load using exports
-				int64_t* usings = (int64_t*)(prime_obj->magic + prime_obj->include_offset);
+			const auto cores = std::max(1u, std::thread::hardware_concurrency() / 2);
 
-				for (size_t i = 0; i < prime_obj->include_count; i++)
+			for (auto i = 0u; i < cores; ++i)
+			{
+				threads.emplace_back([&]()
 				{
-					game::BO4_AssetRef_t ref{ usings[i], 0 };
-					xassets::scriptparsetree_header* spt = xassets::DB_FindXAssetHeader(xassets::ASSET_TYPE_SCRIPTPARSETREE, &ref, false, -1).scriptparsetree;
-
-					if (!spt || !spt->buffer)
+					for (uint32_t obj = next_script++; obj < count; obj = next_script++)
 					{
-						error++;
-						logger::write(logger::LOG_TYPE_ERROR, "[%s] Can't find #using %s in %s", inst ? "CSC" : "GSC", hashes::lookup_tmp("script", ref.hash), hashes::lookup_tmp("script", prime_obj->name));
-						continue;
-					}
-
-					game::GSC_EXPORT_ITEM* exports_using = (game::GSC_EXPORT_ITEM*)(spt->buffer->magic + spt->buffer->exports_offset);
+						game::GSC_OBJ* prime_obj = (*game::gObjFileInfo)[inst][obj].activeVersion;
 
-					for (size_t j = 0; j < spt->buffer->exports_count; j++)
-					{
-						if (exports_using[j].flags & game::GSC_EXPORT_FLAGS::GEF_PRIVATE)
+						if (prime_obj)
 						{
-							continue; // can't import private exports
+							find_script_linking_issues(script_indexes[inst], usings, prime_obj, issues[obj]);
 						}
-						availables[exports_using[j].name_space].insert(exports_using[j].name);
 					}
-				}
-
-				game::GSC_IMPORT_ITEM* imports = (game::GSC_IMPORT_ITEM*)(prime_obj->magic + prime_obj->imports_offset);
+				});
+			}
 
-				for (size_t i = 0; i < prime_obj->imports_count; i++)
+			for (auto& t : threads)
+			{
+				if (t.joinable())
 				{
-					game::GSC_IMPORT_ITEM* imp = imports;
-
-					uint32_t* locations = reinterpret_cast<uint32_t*>(imp + 1);
-					imports = reinterpret_cast<game::GSC_IMPORT_ITEM*>(locations + imp->num_address);
-
-					if (imp->flags & game::GSC_IMPORT_FLAGS::GIF_DEV_CALL)
-					{
-						// ignore dev calls
-						continue;
-					}
-
-					auto itn = availables.find(imp->name_space);
-
-					if (itn != availables.end() && itn->second.contains(imp->name))
-					{
-						continue;
-					}
-
-					byte import_type = imp->flags & game::GSC_IMPORT_FLAGS::GIF_CALLTYPE_MASK;
-
-					// search builtin calls
-					if ((imp->flags & game::GSC_IMPORT_FLAGS::GIF_GET_CALL) != 0 || imp->name_space == 0xC1243180 || imp->name_space == 0x222276A9)
-					{
-
-						int type{};
-						int ignored{};
-						if (import_type == game::GSC_IMPORT_FLAGS::GIF_FUNC_METHOD || import_type == game::GSC_IMPORT_FLAGS::GIF_FUNCTION)
-						{
-							// &func or func()
-							if (inst)
-							{
-								if (game::CScr_GetFunction(imp->name, &type, &ignored, &ignored) && !type)
-								{
-									continue;
-								}
-							}
-							else
-							{
-								if (game::Scr_GetFunction(imp->name, &type, &ignored, &ignored) && !type)
-								{
-									continue;
-								}
-							}
-						}
-
-						if (import_type == game::GSC_IMPORT_FLAGS::GIF_FUNC_METHOD || import_type == game::GSC_IMPORT_FLAGS::GIF_METHOD)
-						{
-							// &meth or <x> meth()
-							if (inst)
-							{
-								if (game::CScr_GetMethod(imp->name, &type, &ignored, &ignored) && !type)
-								{
-									continue;
-								}
-							}
-							else
-							{
-								if (game::Scr_GetMethod(imp->name, &type, &ignored, &ignored) && !type)
-								{
-									continue;
-								}
-							}
-						}
-					}
-
-					const char* func;
+					t.join();
+				}
+			}
 
-					if ((imp->flags & game::GSC_IMPORT_FLAGS::GIF_GET_CALL) != 0 || imp->name_space == 0xC1243180 || imp->name_space == 0x222276A9)
-					{
-						func = hashes::lookup_tmp("function", imp->name);
-					}
-					else
-					{
-						func = utilities::string::va("%s::%s", hashes::lookup_tmp("namespace", imp->name_space), hashes::lookup_tmp("function", imp->name));
-					}
+			for (uint32_t obj = 0; obj < count; obj++)
+			{
+				game::GSC_OBJ* prime_obj = (*game::gObjFileInfo)[inst][obj].activeVersion;
 
-					const char* prefix;
+				if (!prime_obj)
+				{
+					continue;
+				}
 
-					switch (import_type)
-					{
-					case game::GIF_FUNC_METHOD:
-						prefix = "&";
-						break;
-					case game::GIF_FUNCTION:
-					case game::GIF_METHOD:
-						prefix = "";
-						break;
-					case game::GIF_FUNCTION_THREAD:
-					case game::GIF_METHOD_THREAD:
-						prefix = "thread ";
-						break;
-					case game::GIF_FUNCTION_CHILDTHREAD:
-					case game::GIF_METHOD_CHILDTHREAD:
-						prefix = "childthread ";
-						break;
-					default:
-						prefix = "<error>";
-						break;
-					}
+				for (uint64_t include : issues[obj].missing_usings)
+				{
+					error++;
+					logger::write(logger::LOG_TYPE_ERROR, "[%s] Can't find #using %s in %s", inst ? "CSC" : "GSC", hashes::lookup_tmp("script", include), hashes::lookup_tmp("script", prime_obj->name));
+				}
 
-					logger::write(logger::LOG_TYPE_ERROR, "[%s] Unknown import %s%s in %s",
-						inst ? "CSC" : "GSC", prefix, func, hashes::lookup_tmp("script", prime_obj->name)
-					);
-					for (size_t j = 0; j < imp->num_address; j++)
-					{
-						const char* scriptname{};
-						int32_t sloc{};
-						int32_t crc{};
-						int32_t vm{};
-						game::Scr_GetGscExportInfo(inst, prime_obj->magic + locations[j], &scriptname, &sloc, &crc, &vm);
-						if (scriptname)
-						{
-							logger::write(logger::LOG_TYPE_ERROR, "[%s] at %s", inst ? "CSC" : "GSC", scriptname);
-						}
-						else
-						{
-							logger::write(logger::LOG_TYPE_ERROR, "[%s] at %s@%lx", inst ? "CSC" : "GSC", hashes::lookup_tmp("script", prime_obj->name), locations[j]);
-						}
-					}
+				for (game::GSC_IMPORT_ITEM* imp : issues[obj].unknown_imports)
+				{
+					report_unknown_import(inst, prime_obj, imp);
 				}
 			}
 
@@ -517,14 +984,24 @@ namespace gsc_custom
 	{
 		if (game::gObjFileInfoCount[inst] == 0)
 		{
-			// first script for this instance, we can clear previous GSIC
+			// first script for this instance, we can clear previous GSIC and exports
 			gsc_custom::clear_gsic(inst);
+			gsc_custom::clear_script_index(inst);
+
+			// new map, the saves of the previous one are written before it starts
+			gsc_saves::flush();
 		}
 
 		scr_get_gsc_obj_hook.invoke<void>(inst, name, runScript);
 
+		// index the exports of the new linked scripts group
+		gsc_custom::update_script_index(inst);
+
 		// link the detours with the new linked scripts group
 		gsc_custom::link_detours(inst);
+
+		// new exports can resolve call sites that didn't before
+		gsc_custom::invalidate_links(inst);
 	}
 
 	int32_t gsc_obj_resolve_stub(game::scriptInstance_t inst, game::GSC_OBJ* prime_obj)
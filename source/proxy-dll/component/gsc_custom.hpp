@@ -31,5 +31,9 @@ namespace gsc_custom
 	};
 
 	void sync_gsic(game::scriptInstance_t inst, gsic_info& info);
+	byte* find_export(game::scriptInstance_t inst, uint64_t target_script, uint32_t name_space, uint32_t name);
+	game::GSC_OBJ* find_script(game::scriptInstance_t inst, uint64_t script);
+	// lock free, the export is the closest one before codepos
+	game::GSC_OBJ* find_code_script(game::scriptInstance_t inst, const byte* codepos, const game::GSC_EXPORT_ITEM** export_item);
 	void find_linking_issues();
 }
\ No newline at end of file
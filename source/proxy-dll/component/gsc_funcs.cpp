@@ -1,6 +1,8 @@
 #include <std_include.hpp>
 #include "gsc_funcs.hpp"
 #include "gsc_custom.hpp"
+#include "gsc_saves.hpp"
+#include "builtin_stats.hpp"
 #include "hashes.hpp"
 #include "definitions/game.hpp"
 #include "definitions/xassets.hpp"
@@ -82,6 +84,59 @@ namespace gsc_funcs
 
 	namespace
 	{
+		// custom builtins by canon id, with the reverse map from the action function
+		class builtin_table
+		{
+		public:
+			builtin_table(std::initializer_list<game::BO4_BuiltinFunctionDef> defs)
+			{
+				for (const game::BO4_BuiltinFunctionDef& def : defs)
+				{
+					this->add(def);
+				}
+			}
+
+			bool add(const game::BO4_BuiltinFunctionDef& def)
+			{
+				if (!this->functions_.emplace(def.canonId, def).second)
+				{
+					return false; // the first registration is kept
+				}
+
+				this->canon_ids_.emplace(reinterpret_cast<const void*>(def.actionFunc), def.canonId);
+				return true;
+			}
+
+			const game::BO4_BuiltinFunctionDef* find(uint32_t canon_id) const
+			{
+				auto it = this->functions_.find(canon_id);
+
+				if (it == this->functions_.end())
+				{
+					return nullptr;
+				}
+
+				return &it->second;
+			}
+
+			bool find_canon_id(const void* func, uint32_t* canon_id) const
+			{
+				auto it = this->canon_ids_.find(func);
+
+				if (it == this->canon_ids_.end())
+				{
+					return false;
+				}
+
+				*canon_id = it->second;
+				return true;
+			}
+
+		private:
+			std::unordered_map<uint32_t, game::BO4_BuiltinFunctionDef> functions_{};
+			std::unordered_map<const void*, uint32_t> canon_ids_{};
+		};
+
 		constexpr auto gsc_json_data_name_max_length = 40;
 		constexpr const char* gsc_json_type = "$.type";
 		enum hud_elem_align_x
@@ -564,50 +619,127 @@ namespace gsc_funcs
 			xassets::BG_Cache_RegisterAndGet((xassets::BGCacheTypes)type, &hashRef);
 		}
 
-		void shield_to_json_val(game::scriptInstance_t inst, game::ScrVarValue_t* val, rapidjson::Value& member, rapidjson::Document& doc, int depth)
+		enum json_node_type : uint8_t
+		{
+			JSON_NULL = 0,
+			JSON_BOOL,
+			JSON_INTEGER,
+			JSON_FLOAT,
+			JSON_STRING,
+			JSON_LIST,
+			JSON_ARRAY, // object with the array $.type
+			JSON_VECTOR,
+			JSON_HASH,
+			JSON_STRUCT
+		};
+
+		enum json_key_type : uint8_t
+		{
+			JSON_KEY_NONE = 0,
+			JSON_KEY_SKIP,
+			JSON_KEY_FIELD,
+			JSON_KEY_INT_INDEX,
+			JSON_KEY_STRING_INDEX
+		};
+
+		// parsed json node, the nodes are stored in pre order with the index after their children
+		struct json_node
+		{
+			json_node_type type{};
+			json_key_type key_type{};
+			uint32_t end{};
+			uint64_t key{};
+			union
+			{
+				bool boolean;
+				int64_t integer;
+				float number;
+				uint64_t hash;
+			} value{};
+			game::vec3_t vec{};
+			std::string str{};
+		};
+
+		using json_nodes = std::vector<json_node>;
+
+		struct json_cache_entry
+		{
+			std::filesystem::file_time_type time{};
+			std::shared_ptr<const json_nodes> nodes{};
+		};
+
+		// parsed saves by path, so by instance and name
+		std::mutex json_cache_mutex{};
+		std::unordered_map<std::string, json_cache_entry> json_cache{};
+
+		void invalidate_json_cache(game::scriptInstance_t inst, const char* fileid)
+		{
+			std::lock_guard _(json_cache_mutex);
+			json_cache.erase(gsc_saves::get_path(inst, fileid));
+		}
+
+		using json_writer = rapidjson::PrettyWriter<rapidjson::StringBuffer>;
+
+		void shield_to_json_key(json_writer& writer, const std::string& key)
+		{
+			writer.Key(key.data(), (rapidjson::SizeType)key.length(), true);
+		}
+
+		void shield_to_json_val(game::scriptInstance_t inst, game::ScrVarValue_t* val, json_writer& writer, int depth)
 		{
 			if (depth >= 10)
 			{
 				// avoid recursion
-				member.SetNull();
+				writer.Null();
 				return;
 			}
 			switch (val->type)
 			{
-			case game::TYPE_UNDEFINED: return; // ignore
+			case game::TYPE_UNDEFINED:
+			{
+				writer.Null();
+			}
+			break;
 			case game::TYPE_FLOAT:
 			{
-				member.SetFloat(val->u.floatValue);
+				writer.Double(val->u.floatValue);
 			}
 			break;
 			case game::TYPE_INTEGER:
 			{
-				member.SetInt64(val->u.intValue);
+				writer.Int64(val->u.intValue);
 			}
 			break;
 			case game::TYPE_STRING:
 			{
-				member.SetString(game::ScrStr_ConvertToString(val->u.pointerValue), doc.GetAllocator());
+				writer.String(game::ScrStr_ConvertToString(val->u.pointerValue));
 			}
 			break;
 			case game::TYPE_VECTOR:
 			{
-				member.SetObject();
-				auto obj = member.GetObj();
-				obj.AddMember(rapidjson::StringRef(gsc_json_type), "vector", doc.GetAllocator());
-				obj.AddMember(rapidjson::StringRef("x"), val->u.vectorValue[0], doc.GetAllocator());
-				obj.AddMember(rapidjson::StringRef("y"), val->u.vectorValue[1], doc.GetAllocator());
-				obj.AddMember(rapidjson::StringRef("z"), val->u.vectorValue[2], doc.GetAllocator());
+				writer.StartObject();
+				writer.Key(gsc_json_type);
+				writer.String("vector");
+				writer.Key("x");
+				writer.Double(val->u.vectorValue[0]);
+				writer.Key("y");
+				writer.Double(val->u.vectorValue[1]);
+				writer.Key("z");
+				writer.Double(val->u.vectorValue[2]);
+				writer.EndObject();
 			}
 			break;
 			case game::TYPE_HASH:
 			{
-				member.SetObject();
-				auto obj = member.GetObj();
-				obj.AddMember(rapidjson::StringRef(gsc_json_type), "hash", doc.GetAllocator());
 				auto hash = val->u.intValue & 0x7FFFFFFFFFFFFFFF;
 				std::string name = std::format("hash_{:x}", hash);
-				obj.AddMember(rapidjson::StringRef("hash"), name, doc.GetAllocator());
+
+				writer.StartObject();
+				writer.Key(gsc_json_type);
+				writer.String("hash");
+				writer.Key("hash");
+				writer.String(name.data(), (rapidjson::SizeType)name.length(), true);
+				writer.EndObject();
 			}
 			break;
 			case game::TYPE_POINTER:
@@ -615,13 +747,12 @@ namespace gsc_funcs
 				game::ScrVarIndex_t ptr_id = val->u.pointerValue;
 				game::ScrVarValue_t& ptr_val = game::scrVarGlob[inst].scriptValues[ptr_id];
 
-				member.SetObject();
-				auto obj = member.GetObj();
+				writer.StartObject();
 
-				
 				if (ptr_val.type == game::TYPE_ARRAY)
 				{
-					obj.AddMember(rapidjson::StringRef(gsc_json_type), "array", doc.GetAllocator());
+					writer.Key(gsc_json_type);
+					writer.String("array");
 
 					auto size = game::scrVarGlob[inst].scriptVariablesObjectInfo1[ptr_id].size;
 					if (size)
@@ -631,26 +762,18 @@ namespace gsc_funcs
 
 						while (var)
 						{
-							rapidjson::Value subval{};
-
-							// read struct value
-							shield_to_json_val(inst, value, subval, doc, depth + 1);
-
 							if (var->_anon_0.nameType == 1) // integer index
 							{
-								std::string keyval = std::format("{}", var->nameIndex);
-								rapidjson::Value keyjson{ rapidjson::kStringType };
-								keyjson.SetString(keyval, doc.GetAllocator());
-								obj.AddMember(keyjson, subval, doc.GetAllocator());
+								shield_to_json_key(writer, std::format("{}", var->nameIndex));
 							}
 							else
 							{
-								std::string keyval = std::format("#var_{:x}", var->nameIndex);
-								rapidjson::Value keyjson{ rapidjson::kStringType };
-								keyjson.SetString(keyval, doc.GetAllocator());
-								obj.AddMember(keyjson, subval, doc.GetAllocator());
+								shield_to_json_key(writer, std::format("#var_{:x}", var->nameIndex));
 							}
 
+							// read struct value
+							shield_to_json_val(inst, value, writer, depth + 1);
+
 							if (!var->nextSibling)
 							{
 								break;
@@ -660,10 +783,8 @@ namespace gsc_funcs
 							var = &game::scrVarGlob[inst].scriptVariables[var->nextSibling];
 						}
 					}
-					return;
 				}
-				
-				if (ptr_val.type == game::TYPE_STRUCT)
+				else if (ptr_val.type == game::TYPE_STRUCT)
 				{
 					auto size = game::scrVarGlob[inst].scriptVariablesObjectInfo1[ptr_id].size;
 					if (size)
@@ -673,15 +794,10 @@ namespace gsc_funcs
 
 						while (var)
 						{
-							rapidjson::Value subval{};
+							shield_to_json_key(writer, std::format("var_{:x}", var->nameIndex));
 
 							// read struct value
-							shield_to_json_val(inst, value, subval, doc, depth + 1);
-
-							std::string keyval = std::format("var_{:x}", var->nameIndex);
-							rapidjson::Value keyjson{ rapidjson::kStringType };
-							keyjson.SetString(keyval, doc.GetAllocator());
-							obj.AddMember(keyjson, subval, doc.GetAllocator());
+							shield_to_json_val(inst, value, writer, depth + 1);
 
 							if (!var->nextSibling)
 							{
@@ -692,18 +808,23 @@ namespace gsc_funcs
 							var = &game::scrVarGlob[inst].scriptVariables[var->nextSibling];
 						}
 					}
-					return;
 				}
-				// shared_struct and entity aren't using the same syntax
-				gsc_error("invalid tojson param pointer type: %s", inst, false, game::var_typename[ptr_val.type]);
-				return;
+				else
+				{
+					// shared_struct and entity aren't using the same syntax
+					gsc_error("invalid tojson param pointer type: %s", inst, false, game::var_typename[ptr_val.type]);
+				}
+
+				writer.EndObject();
 			}
 			break;
 			default:
 			{
+				// the value is still written to keep the json valid
+				writer.Null();
 				gsc_error("invalid tojson param type: %s", inst, false, game::var_typename[val->type]);
-				return;
 			}
+			break;
 			}
 		}
 
@@ -724,135 +845,162 @@ namespace gsc_funcs
 				return;
 			}
 
-			std::string file{ std::format("project-bo4/saved/{}/{}.json", (inst ? "client" : "server"), fileid) };
-
-			if (inst)
-			{
-				std::filesystem::create_directories("project-bo4/saved/client");
-			}
-			else
-			{
-				std::filesystem::create_directories("project-bo4/saved/server");
-			}
-
 			game::ScrVarValue_t* val = &game::scrVmPub[inst].top[-1];
 
+			invalidate_json_cache(inst, fileid);
+
 			if (game::ScrVm_GetNumParam(inst) == 1 || val->type == game::TYPE_UNDEFINED)
 			{
-				std::filesystem::remove(file);
+				gsc_saves::remove(inst, fileid);
 				return;
 			}
 
-			rapidjson::Document doc{};
-
-			shield_to_json_val(inst, val, doc, doc, 0);
-
+			// the json is made on the vm thread, the file is written in the background
 			rapidjson::StringBuffer buffer;
-			rapidjson::PrettyWriter<rapidjson::StringBuffer> writer(buffer);
-			doc.Accept(writer);
+			json_writer writer(buffer);
+
+			shield_to_json_val(inst, val, writer, 0);
 
-			std::string json_data(buffer.GetString(), buffer.GetLength());
-			utilities::io::write_file(file, json_data);
+			gsc_saves::write(inst, fileid, std::string(buffer.GetString(), buffer.GetLength()));
 		}
 
-		void shield_from_json_push_struct(game::scriptInstance_t inst, rapidjson::Value& member)
+		// SAX handler converting the json into nodes ready to be pushed in the VM, the
+		// objects are typed when they are closed so $.type can be anywhere in them
+		class json_converter : public rapidjson::BaseReaderHandler<rapidjson::UTF8<>, json_converter>
 		{
-			if (member.IsString())
+		public:
+			json_nodes nodes{};
+
+			bool Null() { this->add(JSON_NULL); return true; }
+			bool Bool(bool b) { this->add(JSON_BOOL).value.boolean = b; return true; }
+			bool Int(int i) { return this->Int64(i); }
+			bool Uint(unsigned u) { return this->Int64(u); }
+			bool Int64(int64_t i) { this->add(JSON_INTEGER).value.integer = i; return true; }
+			bool Uint64(uint64_t u) { return this->Int64((int64_t)u); }
+			bool Double(double d) { this->add(JSON_FLOAT).value.number = (float)d; return true; }
+
+			bool String(const char* str, rapidjson::SizeType length, bool)
 			{
-				game::ScrVm_AddString(inst, member.GetString());
-				return;
+				this->add(JSON_STRING).str.assign(str, length);
+				return true;
 			}
 
-			if (member.IsFloat())
+			bool Key(const char* str, rapidjson::SizeType length, bool)
 			{
-				game::ScrVm_AddFloat(inst, member.GetFloat());
-				return;
+				this->key_.assign(str, length);
+				return true;
 			}
 
-			if (member.IsNumber())
+			bool StartObject() { return this->open(JSON_STRUCT); }
+			bool StartArray() { return this->open(JSON_LIST); }
+
+			bool EndObject(rapidjson::SizeType)
 			{
-				game::ScrVm_AddInt(inst, member.GetInt64());
-				return;
+				this->type_object(this->close());
+				return true;
 			}
 
-			if (member.IsBool())
+			bool EndArray(rapidjson::SizeType)
 			{
-				game::ScrVm_AddBool(inst, member.GetBool());
-				return;
+				this->close();
+				return true;
 			}
 
-			if (member.IsNull())
+		private:
+			std::vector<std::string> keys_{};
+			std::vector<size_t> open_{};
+			std::string key_{};
+
+			json_node& add(json_node_type type)
 			{
-				logger::write(logger::LOG_TYPE_WARN, "ShieldFromJson: read null");
-				game::ScrVm_AddUndefined(inst);
-				return;
+				json_node& node = this->nodes.emplace_back();
+				node.type = type;
+				node.end = (uint32_t)this->nodes.size();
+
+				this->keys_.emplace_back(std::move(this->key_));
+				this->key_.clear();
+
+				return node;
 			}
-			
-			if (member.IsArray())
+
+			bool open(json_node_type type)
 			{
-				auto arr = member.GetArray();
+				this->add(type);
+				this->open_.emplace_back(this->nodes.size() - 1);
+				return true;
+			}
 
-				game::ScrVar_PushArray(inst);
+			size_t close()
+			{
+				size_t index = this->open_.back();
+				this->open_.pop_back();
+				this->nodes[index].end = (uint32_t)this->nodes.size();
+				return index;
+			}
 
-				for (rapidjson::Value& elem : arr)
+			size_t find_member(size_t object, const char* name) const
+			{
+				for (size_t i = object + 1; i < this->nodes[object].end; i = this->nodes[i].end)
 				{
-					shield_from_json_push_struct(inst, elem);
-					game::ScrVm_AddToArray(inst);
+					if (this->keys_[i] == name)
+					{
+						return i;
+					}
 				}
-				return;
+
+				return 0;
 			}
 
-			if (member.IsObject())
+			bool is_number(size_t index) const
 			{
-				auto obj = member.GetObj();
-				auto typefield = obj.FindMember(gsc_json_type);
+				return index && (this->nodes[index].type == JSON_INTEGER || this->nodes[index].type == JSON_FLOAT);
+			}
 
-				if (typefield != obj.MemberEnd() && typefield->value.IsString())
+			float get_float(size_t index) const
+			{
+				const json_node& node = this->nodes[index];
+				return node.type == JSON_INTEGER ? (float)node.value.integer : node.value.number;
+			}
+
+			// the vectors and hashes don't need their members once they are read
+			void drop_members(size_t object)
+			{
+				this->nodes.resize(object + 1);
+				this->keys_.resize(object + 1);
+				this->nodes[object].end = (uint32_t)this->nodes.size();
+			}
+
+			void type_object(size_t object)
+			{
+				size_t typefield = this->find_member(object, gsc_json_type);
+				json_node& node = this->nodes[object];
+
+				if (typefield && this->nodes[typefield].type == JSON_STRING)
 				{
-					const char* type = typefield->value.GetString();
+					const char* type = this->nodes[typefield].str.c_str();
 
 					if (!_strcmpi(type, "array"))
 					{
-						game::ScrVar_PushArray(inst);
+						node.type = JSON_ARRAY;
 
-						game::BO4_AssetRef_t name{};
-
-						for (auto& [key, elem] : obj)
+						for (size_t i = object + 1; i < node.end; i = this->nodes[i].end)
 						{
-							if (!key.IsString())
-							{
-								gsc_error("read bad key value for array", inst, false);
-								return;
-							}
-							if (!_strcmpi(key.GetString(), gsc_json_type))
-							{
-								continue;
-							}
-							const char* keystr = key.GetString();
-							if (!*keystr)
+							const std::string& key = this->keys_[i];
+							json_node& elem = this->nodes[i];
+
+							if (key.empty() || !_strcmpi(key.c_str(), gsc_json_type))
 							{
-								continue;
+								elem.key_type = JSON_KEY_SKIP;
 							}
-							shield_from_json_push_struct(inst, elem);
-
-							if (*keystr == '#')
+							else if (key[0] == '#')
 							{
-								name.hash = fnv1a::generate_hash_pattern(key.GetString() + 1);
-								game::ScrVm_AddToArrayStringIndexed(inst, &name);
+								elem.key_type = JSON_KEY_STRING_INDEX;
+								elem.key = fnv1a::generate_hash_pattern(key.c_str() + 1);
 							}
 							else
 							{
-								uint64_t keyval{};
-								try
-								{
-									keyval = std::strtoull(keystr, nullptr, 10);
-								}
-								catch (const std::invalid_argument& e)
-								{
-									gsc_error("invalid key for array member %s", inst, false, e.what());
-									return;
-								}
-								ScrVm_AddToArrayIntIndexed(inst, keyval);
+								elem.key_type = JSON_KEY_INT_INDEX;
+								elem.key = std::strtoull(key.c_str(), nullptr, 10);
 							}
 						}
 						return;
@@ -860,59 +1008,210 @@ namespace gsc_funcs
 
 					if (!_strcmpi(type, "vector"))
 					{
-						auto x = obj.FindMember("x");
-						auto y = obj.FindMember("y");
-						auto z = obj.FindMember("z");
+						size_t x = this->find_member(object, "x");
+						size_t y = this->find_member(object, "y");
+						size_t z = this->find_member(object, "z");
 
-						if (
-							x != obj.MemberEnd() && y != obj.MemberEnd() && z != obj.MemberEnd()
-							&& x->value.IsNumber() && y->value.IsNumber() && z->value.IsNumber())
+						if (this->is_number(x) && this->is_number(y) && this->is_number(z))
 						{
-							game::vec3_t vec{};
-
-							vec[0] = x->value.GetFloat();
-							vec[1] = y->value.GetFloat();
-							vec[2] = z->value.GetFloat();
-							game::ScrVm_AddVector(inst, &vec);
+							node.type = JSON_VECTOR;
+							node.vec[0] = this->get_float(x);
+							node.vec[1] = this->get_float(y);
+							node.vec[2] = this->get_float(z);
+							this->drop_members(object);
 							return;
 						}
 					}
+
 					if (!_strcmpi(type, "hash"))
 					{
-						auto value = obj.FindMember("hash");
-
-						if (value != obj.MemberEnd() && value->value.IsString()) {
-							game::BO4_AssetRef_t hash
-							{
-								.hash = (int64_t)fnv1a::generate_hash_pattern(value->value.GetString())
-							};
+						size_t value = this->find_member(object, "hash");
 
-							game::ScrVm_AddHash(inst, &hash);
+						if (value && this->nodes[value].type == JSON_STRING)
+						{
+							node.type = JSON_HASH;
+							node.value.hash = fnv1a::generate_hash_pattern(this->nodes[value].str.c_str());
+							this->drop_members(object);
 							return;
 						}
 					}
 				}
 
 				// object by default
-				uint32_t struct_id = game::ScrVm_AddStruct(inst);
+				for (size_t i = object + 1; i < node.end; i = this->nodes[i].end)
+				{
+					const std::string& key = this->keys_[i];
+					json_node& elem = this->nodes[i];
+
+					if (!_strcmpi(key.c_str(), gsc_json_type))
+					{
+						elem.key_type = JSON_KEY_SKIP;
+					}
+					else
+					{
+						elem.key_type = JSON_KEY_FIELD;
+						elem.key = canon_hash_pattern(key.c_str());
+					}
+				}
+			}
+		};
+
+		size_t shield_from_json_push_node(game::scriptInstance_t inst, const json_nodes& nodes, size_t index)
+		{
+			const json_node& node = nodes[index];
+
+			switch (node.type)
+			{
+			case JSON_NULL:
+				logger::write(logger::LOG_TYPE_WARN, "ShieldFromJson: read null");
+				game::ScrVm_AddUndefined(inst);
+				break;
+			case JSON_BOOL:
+				game::ScrVm_AddBool(inst, node.value.boolean);
+				break;
+			case JSON_INTEGER:
+				game::ScrVm_AddInt(inst, node.value.integer);
+				break;
+			case JSON_FLOAT:
+				game::ScrVm_AddFloat(inst, node.value.number);
+				break;
+			case JSON_STRING:
+				game::ScrVm_AddString(inst, node.str.c_str());
+				break;
+			case JSON_LIST:
+			{
+				game::ScrVar_PushArray(inst);
 
-				for (auto& [key, elem] : obj)
+				for (size_t i = index + 1; i < node.end; )
 				{
-					if (!key.IsString())
+					i = shield_from_json_push_node(inst, nodes, i);
+					game::ScrVm_AddToArray(inst);
+				}
+			}
+			break;
+			case JSON_ARRAY:
+			{
+				game::ScrVar_PushArray(inst);
+
+				game::BO4_AssetRef_t name{};
+
+				for (size_t i = index + 1; i < node.end; )
+				{
+					const json_node& elem = nodes[i];
+
+					if (elem.key_type == JSON_KEY_SKIP)
 					{
-						gsc_error("read bad key value for struct", inst, false);
-						return;
+						i = elem.end;
+						continue;
+					}
+
+					i = shield_from_json_push_node(inst, nodes, i);
+
+					if (elem.key_type == JSON_KEY_STRING_INDEX)
+					{
+						name.hash = (int64_t)elem.key;
+						game::ScrVm_AddToArrayStringIndexed(inst, &name);
 					}
-					if (!_strcmpi(key.GetString(), gsc_json_type))
+					else
 					{
+						ScrVm_AddToArrayIntIndexed(inst, elem.key);
+					}
+				}
+			}
+			break;
+			case JSON_VECTOR:
+			{
+				game::vec3_t vec{ node.vec[0], node.vec[1], node.vec[2] };
+				game::ScrVm_AddVector(inst, &vec);
+			}
+			break;
+			case JSON_HASH:
+			{
+				game::BO4_AssetRef_t hash
+				{
+					.hash = (int64_t)node.value.hash
+				};
+
+				game::ScrVm_AddHash(inst, &hash);
+			}
+			break;
+			case JSON_STRUCT:
+			{
+				uint32_t struct_id = game::ScrVm_AddStruct(inst);
+
+				for (size_t i = index + 1; i < node.end; )
+				{
+					const json_node& elem = nodes[i];
+
+					if (elem.key_type == JSON_KEY_SKIP)
+					{
+						i = elem.end;
 						continue;
 					}
-					shield_from_json_push_struct(inst, elem);
-					game::ScrVm_SetStructField(inst, struct_id, canon_hash_pattern(key.GetString()));
+
+					i = shield_from_json_push_node(inst, nodes, i);
+					game::ScrVm_SetStructField(inst, struct_id, (uint32_t)elem.key);
 				}
-				return;
 			}
-			gsc_error("bad json element: %d", inst, false, (int)member.GetType());
+			break;
+			}
+
+			return node.end;
+		}
+
+		std::shared_ptr<const json_nodes> parse_json(const std::string& file, const std::string& file_content)
+		{
+			json_converter converter{};
+			rapidjson::Reader reader{};
+			rapidjson::StringStream stream{ file_content.c_str() };
+
+			rapidjson::ParseResult result = reader.Parse(stream, converter);
+
+			if (result.IsError())
+			{
+				logger::write(logger::LOG_TYPE_WARN, "can't parse json file %s: error %d at %llu", file.c_str(), (int)result.Code(), (uint64_t)result.Offset());
+
+				// read as null like an empty document
+				converter.nodes.clear();
+				converter.nodes.emplace_back().end = 1;
+			}
+
+			return std::make_shared<const json_nodes>(std::move(converter.nodes));
+		}
+
+		std::shared_ptr<const json_nodes> get_json_nodes(game::scriptInstance_t inst, const char* fileid)
+		{
+			std::string file = gsc_saves::get_path(inst, fileid);
+
+			// the time is read before the file, a write in between only makes the entry outdated
+			std::error_code ec{};
+			std::filesystem::file_time_type time = std::filesystem::last_write_time(file, ec);
+
+			{
+				std::lock_guard _(json_cache_mutex);
+
+				auto it = json_cache.find(file);
+
+				if (it != json_cache.end() && !ec && it->second.time == time)
+				{
+					return it->second.nodes;
+				}
+			}
+
+			std::string file_content{};
+
+			if (!gsc_saves::read(inst, fileid, &file_content))
+			{
+				logger::write(logger::LOG_TYPE_WARN, "trying to read unknown config file %s", file.c_str());
+				return nullptr;
+			}
+
+			std::shared_ptr<const json_nodes> nodes = parse_json(file, file_content);
+
+			std::lock_guard _(json_cache_mutex);
+			json_cache[file] = { time, nodes };
+
+			return nodes;
 		}
 
 		void shield_from_json(game::scriptInstance_t inst)
@@ -931,21 +1230,13 @@ namespace gsc_funcs
 				gsc_error("json name can't be longer than %d", inst, false, gsc_json_data_name_max_length);
 				return;
 			}
-			
-			std::string file{ std::format("project-bo4/saved/{}/{}.json", (inst ? "client" : "server"), fileid) };
 
-			std::string file_content{};
+			std::shared_ptr<const json_nodes> nodes = get_json_nodes(inst, fileid);
 
-			if (!utilities::io::read_file(file, &file_content))
+			if (nodes)
 			{
-				logger::write(logger::LOG_TYPE_WARN, "trying to read unknown config file %s", file.c_str());
-				return;
+				shield_from_json_push_node(inst, *nodes, 0);
 			}
-
-			rapidjson::Document doc{};
-			doc.Parse(file_content);
-
-			shield_from_json_push_struct(inst, doc);
 		}
 
 		void add_debug_command(game::scriptInstance_t inst)
@@ -1001,7 +1292,7 @@ namespace gsc_funcs
 		}
 
 		
-		game::BO4_BuiltinFunctionDef custom_functions_gsc[] =
+		builtin_table custom_functions_gsc =
 		{
 			{ // ShieldLog(message)
 				.canonId = canon_hash("ShieldLog"),
@@ -1109,7 +1400,7 @@ namespace gsc_funcs
 				.type = 0
 			}
 		};
-		game::BO4_BuiltinFunctionDef custom_functions_csc[] =
+		builtin_table custom_functions_csc =
 		{
 			{ // ShieldLog(message)
 				.canonId = canon_hash("ShieldLog"),
@@ -1244,6 +1535,19 @@ namespace gsc_funcs
 	bool enable_dev_func = false;
 	bool enable_dev_blocks = false;
 
+	bool register_builtin(game::scriptInstance_t inst, const game::BO4_BuiltinFunctionDef& def)
+	{
+		builtin_table& table = inst ? custom_functions_csc : custom_functions_gsc;
+
+		if (!table.add(def))
+		{
+			logger::write(logger::LOG_TYPE_ERROR, std::format("the builtin {} was registered twice", lookup_hash(inst, "function", def.canonId)));
+			return false;
+		}
+
+		return true;
+	}
+
 	utilities::hook::detour scr_get_function_reverse_lookup;
 	utilities::hook::detour cscr_get_function_reverse_lookup;
 	utilities::hook::detour scr_get_function;
@@ -1254,16 +1558,15 @@ namespace gsc_funcs
 
 	bool scr_get_function_reverse_lookup_stub(void* func, uint32_t* hash, bool* isFunction)
 	{
+		func = builtin_stats::unwrap(func);
+
 		if (scr_get_function_reverse_lookup.invoke<bool>(func, hash, isFunction))
 		{
 			return true;
 		}
 
-		auto f = std::find_if(std::begin(custom_functions_gsc), std::end(custom_functions_gsc), [func](const game::BO4_BuiltinFunctionDef& def) { return def.actionFunc == func; });
-
-		if (f != std::end(custom_functions_gsc))
+		if (custom_functions_gsc.find_canon_id(func, hash))
 		{
-			*hash = f->canonId;
 			*isFunction = true;
 			return true;
 		}
@@ -1272,16 +1575,15 @@ namespace gsc_funcs
 	}
 	bool cscr_get_function_reverse_lookup_stub(void* func, uint32_t* hash, bool* isFunction)
 	{
+		func = builtin_stats::unwrap(func);
+
 		if (cscr_get_function_reverse_lookup.invoke<bool>(func, hash, isFunction))
 		{
 			return true;
 		}
 
-		auto f = std::find_if(std::begin(custom_functions_csc), std::end(custom_functions_csc), [func](const game::BO4_BuiltinFunctionDef& def) { return def.actionFunc == func; });
-
-		if (f != std::end(custom_functions_csc))
+		if (custom_functions_csc.find_canon_id(func, hash))
 		{
-			*hash = f->canonId;
 			*isFunction = true;
 			return true;
 		}
@@ -1300,18 +1602,18 @@ namespace gsc_funcs
 
 		if (func)
 		{
-			return func;
+			return builtin_stats::wrap(game::SCRIPTINSTANCE_SERVER, name, false, func);
 		}
 
-		auto f = std::find_if(std::begin(custom_functions_gsc), std::end(custom_functions_gsc), [name](const game::BO4_BuiltinFunctionDef& func) { return func.canonId == name; });
+		const game::BO4_BuiltinFunctionDef* f = custom_functions_gsc.find(name);
 
-		if (f != std::end(custom_functions_gsc))
+		if (f)
 		{
 			*type = f->type && !enable_dev_func;
 			*min_args = f->min_args;
 			*max_args = f->max_args;
 
-			return f->actionFunc;
+			return builtin_stats::wrap(game::SCRIPTINSTANCE_SERVER, name, false, f->actionFunc);
 		}
 
 		return nullptr;
@@ -1327,18 +1629,18 @@ namespace gsc_funcs
 
 		if (func)
 		{
-			return func;
+			return builtin_stats::wrap(game::SCRIPTINSTANCE_CLIENT, name, false, func);
 		}
 
-		auto f = std::find_if(std::begin(custom_functions_csc), std::end(custom_functions_csc), [name](const game::BO4_BuiltinFunctionDef& func) { return func.canonId == name; });
+		const game::BO4_BuiltinFunctionDef* f = custom_functions_csc.find(name);
 
-		if (f != std::end(custom_functions_csc))
+		if (f)
 		{
 			*type = f->type && !enable_dev_func;
 			*min_args = f->min_args;
 			*max_args = f->max_args;
 
-			return f->actionFunc;
+			return builtin_stats::wrap(game::SCRIPTINSTANCE_CLIENT, name, false, f->actionFunc);
 		}
 
 		return nullptr;
@@ -1352,7 +1654,7 @@ namespace gsc_funcs
 			*type = 0;
 		}
 
-		return func;
+		return builtin_stats::wrap(game::SCRIPTINSTANCE_SERVER, name, true, func);
 	}
 	void* cscr_get_method_stub(uint32_t name, int32_t* type, int32_t* min_args, int32_t* max_args)
 	{
@@ -1363,7 +1665,7 @@ namespace gsc_funcs
 			*type = 0;
 		}
 
-		return func;
+		return builtin_stats::wrap(game::SCRIPTINSTANCE_CLIENT, name, true, func);
 	}
 
 	void scrvm_error_stub(uint64_t code, game::scriptInstance_t inst, char* unused, bool terminal)
@@ -1450,50 +1752,13 @@ namespace gsc_funcs
 	void get_gsc_export_info(game::scriptInstance_t inst, byte* codepos, const char** scriptname, int32_t* sloc, int32_t* crc, int32_t* vm)
 	{
 		static char scriptnamebuffer[game::scriptInstance_t::SCRIPTINSTANCE_MAX][0x200];
-		game::GSC_OBJ* script_obj = nullptr;
-		{
-			game::scoped_critical_section scs{ 0x36, game::SCOPED_CRITSECT_NORMAL };
-
-			uint32_t count = game::gObjFileInfoCount[inst];
-
-			for (size_t i = 0; i < count; i++)
-			{
-				game::objFileInfo_t& info = (*game::gObjFileInfo)[inst][i];
-
-				game::GSC_OBJ* obj = info.activeVersion;
-
-				if (codepos >= obj->magic + obj->cseg_offset && codepos < obj->magic + obj->cseg_offset + obj->cseg_size)
-				{
-					script_obj = obj;
-					break;
-				}
-			}
-		}
+		const game::GSC_EXPORT_ITEM* export_item = nullptr;
+		game::GSC_OBJ* script_obj = gsc_custom::find_code_script(inst, codepos, &export_item);
 
 		if (script_obj)
 		{
-			game::GSC_EXPORT_ITEM* export_item = nullptr;
-
 			uint32_t rloc = (uint32_t)(codepos - script_obj->magic);
 
-			for (size_t i = 0; i < script_obj->exports_count; i++)
-			{
-				game::GSC_EXPORT_ITEM* exp = reinterpret_cast<game::GSC_EXPORT_ITEM*>(script_obj->magic + script_obj->exports_offset) + i;
-
-				if (rloc < exp->address)
-				{
-					continue; // our code is after
-				}
-
-				if (export_item && export_item->address > exp->address)
-				{
-					continue; // we already have a better candidate
-				}
-
-				export_item = exp;
-			}
-
-
 			if (scriptname)
 			{
 				if (export_item)
@@ -1563,4 +1828,18 @@ namespace gsc_funcs
 	};
 }
 
+extern "C"
+{
+	// plugin entry point, should be called from PBO4_PreStart or PBO4_PostUnpack before any script is linked
+	__declspec(dllexport) bool PBO4_RegisterBuiltin(game::scriptInstance_t inst, const char* name, uint32_t min_args, uint32_t max_args, game::BuiltinFunction func, uint32_t type)
+	{
+		if (inst < 0 || inst >= game::SCRIPTINSTANCE_MAX || !name || !func)
+		{
+			return false;
+		}
+
+		return gsc_funcs::register_builtin(inst, { gsc_funcs::canon_hash(name), min_args, max_args, func, type });
+	}
+}
+
 REGISTER_COMPONENT(gsc_funcs::component)
\ No newline at end of file
@@ -16,4 +16,7 @@ namespace gsc_funcs
 	const char* lookup_hash(game::scriptInstance_t inst, const char* type, uint64_t hash);
 
 	void ScrVm_AddToArrayIntIndexed(game::scriptInstance_t inst, uint64_t index);
+
+	// add a custom builtin function, must be done before the scripts are linked
+	bool register_builtin(game::scriptInstance_t inst, const game::BO4_BuiltinFunctionDef& def);
 }
\ No newline at end of file
@@ -0,0 +1,406 @@
+#include <std_include.hpp>
+#include "command.hpp"
+#include "gsc_custom.hpp"
+#include "hashes.hpp"
+#include "definitions/game.hpp"
+#include "loader/component_loader.hpp"
+
+#include <utilities/io.hpp>
+#include <utilities/thread.hpp>
+
+namespace gsc_profiler
+{
+	namespace
+	{
+		constexpr const char* profiler_dir = "project-bo4/profiler";
+		constexpr uint32_t default_interval = 5; // ms
+
+		struct profile_frame
+		{
+			uint64_t script{};
+			uint32_t name_space{};
+			uint32_t function{};
+			uint32_t file{};
+			uint32_t line{};
+
+			auto operator<=>(const profile_frame& other) const = default;
+		};
+
+		using profile_stack = std::vector<profile_frame>;
+
+		struct line_range
+		{
+			uint32_t start;
+			uint32_t end;
+			uint32_t file;
+			uint32_t line;
+		};
+
+		// ACTS line table of a linked script, sorted by code location
+		struct line_table
+		{
+			uint64_t script{};
+			int32_t crc{};
+			std::vector<line_range> lines{};
+		};
+
+		struct profile_state
+		{
+			std::chrono::milliseconds interval{};
+			uint64_t samples[game::SCRIPTINSTANCE_MAX]{};
+			std::map<profile_stack, uint64_t> stacks[game::SCRIPTINSTANCE_MAX]{};
+
+			// only read by the sampler, the scripts are matched by name and crc before reusing a table
+			std::unordered_map<const game::GSC_OBJ*, line_table> line_tables{};
+			std::vector<std::string> files{ "" };
+			std::unordered_map<std::string, uint32_t> file_ids{};
+		};
+
+		std::mutex profiler_mutex{};
+		std::thread profiler_thread{};
+		std::atomic_bool profiler_running{};
+		std::unique_ptr<profile_state> state{};
+
+		uint32_t get_file_id(profile_state& st, const char* filename)
+		{
+			auto [it, inserted] = st.file_ids.try_emplace(filename, (uint32_t)st.files.size());
+
+			if (inserted)
+			{
+				st.files.emplace_back(filename);
+			}
+
+			return it->second;
+		}
+
+		void load_line_table(profile_state& st, game::GSC_OBJ* obj, line_table& table)
+		{
+			table.script = obj->name;
+			table.crc = obj->crc;
+			table.lines.clear();
+
+			byte* start = obj->magic;
+			auto& dbg = *reinterpret_cast<game::acts_debug::GSC_ACTS_DEBUG*>(start + sizeof(game::GSC_OBJ));
+
+			if (std::memcmp(dbg.magic, &game::acts_debug::MAGIC, sizeof(dbg.magic)) || !dbg.has_feature(game::acts_debug::ADF_LINES))
+			{
+				return; // not compiled with the line debug data
+			}
+
+			table.lines.reserve(dbg.lines_count);
+
+			for (const game::acts_debug::GSC_ACTS_LINES* line = dbg.get_lines(start); line != dbg.get_lines_end(start); line++)
+			{
+				line_range& range = table.lines.emplace_back(line_range{ line->start, line->end, 0, (uint32_t)line->lineNum });
+
+				// the lines are in the preprocessed script, the file table maps them back to their sources
+				for (const game::acts_debug::GSC_ACTS_FILES* file = dbg.get_files(start); file != dbg.get_files_end(start); file++)
+				{
+					if (line->lineNum >= file->lineStart && line->lineNum <= file->lineEnd)
+					{
+						range.file = get_file_id(st, reinterpret_cast<const char*>(start + file->filename));
+						range.line = (uint32_t)(line->lineNum - file->lineStart);
+						break;
+					}
+				}
+			}
+
+			std::sort(table.lines.begin(), table.lines.end(), [](const line_range& a, const line_range& b) { return a.start < b.start; });
+		}
+
+		const line_range* find_line(profile_state& st, game::GSC_OBJ* obj, uint32_t rloc)
+		{
+			line_table& table = st.line_tables[obj];
+
+			if (table.script != obj->name || table.crc != obj->crc)
+			{
+				load_line_table(st, obj, table);
+			}
+
+			auto it = std::upper_bound(table.lines.begin(), table.lines.end(), rloc, [](uint32_t loc, const line_range& range) { return loc < range.start; });
+
+			if (it == table.lines.begin() || rloc >= std::prev(it)->end)
+			{
+				return nullptr;
+			}
+
+			return &*std::prev(it);
+		}
+
+		void sample(profile_state& st, game::scriptInstance_t inst, profile_stack& stack)
+		{
+			game::BO4_scrVmPub& vm = game::scrVmPub[inst];
+
+			if (!vm.vmInitialized || vm.isShutdown)
+			{
+				return;
+			}
+
+			// the first frame keeps the position of the last script that ran, only the running VM is sampled
+			if (vm.function_count <= 0)
+			{
+				return; // idle
+			}
+
+			// the scripts can't be unloaded while their code and debug data are read
+			game::scoped_critical_section scs{ 0x36, game::SCOPED_CRITSECT_NORMAL };
+
+			// the VM is running on its own thread, the frames can be torn so they are only used after validation
+			game::function_frame_t* current = vm.function_frame;
+
+			if (current < vm.function_frame_start || current >= std::end(vm.function_frame_start))
+			{
+				return;
+			}
+
+			stack.clear();
+
+			for (game::function_frame_t* frame = vm.function_frame_start; frame <= current; frame++)
+			{
+				byte* pos = frame->fs.pos;
+				const game::GSC_EXPORT_ITEM* export_item = nullptr;
+				game::GSC_OBJ* obj = gsc_custom::find_code_script(inst, pos, &export_item);
+
+				if (!obj)
+				{
+					continue; // not in a script
+				}
+
+				profile_frame& pf = stack.emplace_back();
+
+				pf.script = obj->name & 0x7FFFFFFFFFFFFFFF;
+
+				if (export_item)
+				{
+					pf.name_space = export_item->name_space;
+					pf.function = export_item->name;
+				}
+
+				const line_range* line = find_line(st, obj, (uint32_t)(pos - obj->magic));
+
+				if (line)
+				{
+					pf.file = line->file;
+					pf.line = line->line;
+				}
+			}
+
+			if (stack.empty())
+			{
+				return; // not in a script
+			}
+
+			st.samples[inst]++;
+			st.stacks[inst][stack]++;
+		}
+
+		void run_sampler(profile_state* st)
+		{
+			profile_stack stack{};
+
+			while (profiler_running)
+			{
+				for (size_t inst = 0; inst < game::SCRIPTINSTANCE_MAX; inst++)
+				{
+					sample(*st, (game::scriptInstance_t)inst, stack);
+				}
+
+				std::this_thread::sleep_for(st->interval);
+			}
+		}
+
+		std::string get_function_name(const profile_frame& frame)
+		{
+			std::string script = hashes::lookup_tmp("script", frame.script);
+
+			if (!frame.function)
+			{
+				return script;
+			}
+
+			return std::format("{}::{}", script, hashes::lookup_tmp("function", frame.function));
+		}
+
+		std::string get_line_name(const profile_state& st, const profile_frame& frame)
+		{
+			if (!frame.file)
+			{
+				return get_function_name(frame);
+			}
+
+			return std::format("{}:{}", st.files[frame.file], frame.line);
+		}
+
+		struct function_time
+		{
+			uint64_t self{};
+			uint64_t total{};
+		};
+
+		void write_report(const profile_state& st, game::scriptInstance_t inst, const std::string& timestamp)
+		{
+			if (!st.samples[inst])
+			{
+				return;
+			}
+
+			const char* vm_name = inst ? "csc" : "gsc";
+			auto to_ms = [&st](uint64_t samples) { return samples * st.interval.count(); };
+
+			// the stacks only differing by their lines are merged in the folded stacks
+			std::map<std::string, uint64_t> folded_stacks{};
+			std::map<std::string, function_time> functions{};
+			std::map<std::string, uint64_t> lines{};
+			std::unordered_set<std::string> seen{};
+
+			for (const auto& [stack, count] : st.stacks[inst])
+			{
+				std::string folded_stack{};
+
+				seen.clear();
+
+				for (const profile_frame& frame : stack)
+				{
+					std::string name = get_function_name(frame);
+
+					if (!folded_stack.empty())
+					{
+						folded_stack += ';';
+					}
+					folded_stack += name;
+
+					// recursive functions are only counted once per stack
+					if (seen.insert(name).second)
+					{
+						functions[name].total += count;
+					}
+				}
+
+				functions[get_function_name(stack.back())].self += count;
+				lines[get_line_name(st, stack.back())] += count;
+
+				folded_stacks[folded_stack] += count;
+			}
+
+			std::string folded{};
+			for (const auto& [folded_stack, count] : folded_stacks)
+			{
+				folded += std::format("{} {}\n", folded_stack, count);
+			}
+
+			std::vector<std::pair<std::string, function_time>> by_self{ functions.begin(), functions.end() };
+			std::sort(by_self.begin(), by_self.end(), [](const auto& a, const auto& b) { return a.second.self > b.second.self; });
+
+			std::vector<std::pair<std::string, uint64_t>> by_line{ lines.begin(), lines.end() };
+			std::sort(by_line.begin(), by_line.end(), [](const auto& a, const auto& b) { return a.second > b.second; });
+
+			std::string report = std::format("{} samples every {}ms ({}ms)\n\n", st.samples[inst], st.interval.count(), to_ms(st.samples[inst]));
+
+			report += std::format("{:>10} {:>10} {:>10} {:>10}  {}\n", "self", "self ms", "total", "total ms", "function");
+			for (const auto& [name, time] : by_self)
+			{
+				report += std::format("{:>10} {:>10} {:>10} {:>10}  {}\n", time.self, to_ms(time.self), time.total, to_ms(time.total), name);
+			}
+
+			report += std::format("\n{:>10} {:>10}  {}\n", "self", "self ms", "line");
+			for (const auto& [name, count] : by_line)
+			{
+				report += std::format("{:>10} {:>10}  {}\n", count, to_ms(count), name);
+			}
+
+			std::string base = std::format("{}/{}-{}", profiler_dir, vm_name, timestamp);
+
+			utilities::io::write_file(base + ".folded", folded);
+			utilities::io::write_file(base + ".txt", report);
+
+			logger::write(logger::LOG_TYPE_CONSOLE, std::format("{} profile written to {}.txt", vm_name, base));
+		}
+
+		std::string get_timestamp()
+		{
+			tm ltime{};
+			char timestamp[MAX_PATH] = { 0 };
+			const auto time = _time64(nullptr);
+
+			_localtime64_s(&ltime, &time);
+			strftime(timestamp, sizeof(timestamp) - 1, "%Y-%m-%d-%H-%M-%S", &ltime);
+
+			return timestamp;
+		}
+
+		void profile_start_f(const command::params& params)
+		{
+			std::lock_guard _(profiler_mutex);
+
+			if (profiler_running)
+			{
+				logger::write(logger::LOG_TYPE_CONSOLE, "the gsc profiler is already running");
+				return;
+			}
+
+			uint32_t interval = default_interval;
+
+			if (params.size() > 1)
+			{
+				interval = (uint32_t)std::max(1, std::atoi(params[1]));
+			}
+
+			state = std::make_unique<profile_state>();
+			state->interval = std::chrono::milliseconds{ interval };
+
+			profiler_running = true;
+			profiler_thread = utilities::thread::create_named_thread("GSC Profiler", run_sampler, state.get());
+
+			logger::write(logger::LOG_TYPE_CONSOLE, std::format("gsc profiler started, sampling every {}ms", interval));
+		}
+
+		void stop_profiler()
+		{
+			profiler_running = false;
+
+			if (profiler_thread.joinable())
+			{
+				profiler_thread.join();
+			}
+		}
+
+		void profile_stop_f()
+		{
+			std::lock_guard _(profiler_mutex);
+
+			if (!profiler_running)
+			{
+				logger::write(logger::LOG_TYPE_CONSOLE, "the gsc profiler isn't running");
+				return;
+			}
+
+			stop_profiler();
+
+			std::string timestamp = get_timestamp();
+
+			for (size_t inst = 0; inst < game::SCRIPTINSTANCE_MAX; inst++)
+			{
+				write_report(*state, (game::scriptInstance_t)inst, timestamp);
+			}
+
+			state.reset();
+		}
+	}
+
+	class component final : public component_interface
+	{
+	public:
+		void post_unpack() override
+		{
+			command::add("gsc_profile_start", profile_start_f, "Start sampling the GSC/CSC VMs, usage: gsc_profile_start [interval ms]");
+			command::add("gsc_profile_stop", profile_stop_f, "Stop the GSC/CSC profiler and write its reports");
+		}
+
+		void pre_destroy() override
+		{
+			stop_profiler();
+		}
+	};
+}
+
+REGISTER_COMPONENT(gsc_profiler::component)
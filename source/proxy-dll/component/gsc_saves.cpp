@@ -0,0 +1,181 @@
+#include <std_include.hpp>
+#include "gsc_saves.hpp"
+#include "loader/component_loader.hpp"
+
+#include <utilities/io.hpp>
+#include <utilities/thread.hpp>
+
+namespace gsc_saves
+{
+	namespace
+	{
+		// no data means the save is removed
+		using save_map = std::unordered_map<std::string, std::optional<std::string>>;
+
+		std::mutex saves_mutex{};
+		std::condition_variable saves_cv{};
+		std::condition_variable flushed_cv{};
+		std::thread writer_thread{};
+		bool writer_stopping{};
+
+		save_map queued{};
+		// taken by the writer, kept until they are on the disk for the reads
+		save_map writing{};
+
+		void write_save(const std::string& path, const std::optional<std::string>& data)
+		{
+			std::error_code ec{};
+
+			if (!data)
+			{
+				std::filesystem::remove(path, ec);
+				return;
+			}
+
+			// write and rename, a crash in the middle of a write can't leave a truncated save
+			const auto temp_path = path + ".tmp";
+
+			if (!utilities::io::write_file(temp_path, *data))
+			{
+				logger::write(logger::LOG_TYPE_ERROR, "can't write saved json %s", temp_path.c_str());
+				return;
+			}
+
+			std::filesystem::rename(temp_path, path, ec);
+
+			if (ec)
+			{
+				logger::write(logger::LOG_TYPE_ERROR, "can't replace saved json %s: %s", path.c_str(), ec.message().c_str());
+			}
+		}
+
+		void run_writer()
+		{
+			std::unique_lock lock(saves_mutex);
+
+			while (true)
+			{
+				saves_cv.wait(lock, [] { return writer_stopping || !queued.empty(); });
+
+				if (queued.empty())
+				{
+					break; // stopping and nothing left to write
+				}
+
+				writing = std::move(queued);
+				queued.clear();
+
+				lock.unlock();
+
+				for (const auto& [path, data] : writing)
+				{
+					write_save(path, data);
+				}
+
+				lock.lock();
+
+				writing.clear();
+				flushed_cv.notify_all();
+			}
+		}
+
+		void queue(std::string path, std::optional<std::string> data)
+		{
+			std::unique_lock lock(saves_mutex);
+
+			if (writer_stopping)
+			{
+				// saved during the shutdown, the writer is already gone
+				lock.unlock();
+				write_save(path, data);
+				return;
+			}
+
+			queued[std::move(path)] = std::move(data);
+
+			if (!writer_thread.joinable())
+			{
+				writer_thread = utilities::thread::create_named_thread("GSC Saves", run_writer);
+			}
+
+			saves_cv.notify_one();
+		}
+
+		void stop_writer()
+		{
+			{
+				std::lock_guard _(saves_mutex);
+				writer_stopping = true;
+			}
+
+			saves_cv.notify_one();
+
+			if (writer_thread.joinable())
+			{
+				writer_thread.join();
+			}
+		}
+	}
+
+	std::string get_path(game::scriptInstance_t inst, const std::string& name)
+	{
+		return std::format("project-bo4/saved/{}/{}.json", (inst ? "client" : "server"), name);
+	}
+
+	void write(game::scriptInstance_t inst, const std::string& name, std::string data)
+	{
+		queue(get_path(inst, name), std::move(data));
+	}
+
+	void remove(game::scriptInstance_t inst, const std::string& name)
+	{
+		queue(get_path(inst, name), std::nullopt);
+	}
+
+	bool read(game::scriptInstance_t inst, const std::string& name, std::string* data)
+	{
+		std::string path = get_path(inst, name);
+
+		{
+			std::lock_guard _(saves_mutex);
+
+			for (const save_map* saves : { &queued, &writing })
+			{
+				auto it = saves->find(path);
+
+				if (it == saves->end())
+				{
+					continue;
+				}
+
+				if (!it->second)
+				{
+					return false;
+				}
+
+				*data = *it->second;
+				return true;
+			}
+		}
+
+		return utilities::io::read_file(path, data);
+	}
+
+	void flush()
+	{
+		std::unique_lock lock(saves_mutex);
+		flushed_cv.wait(lock, [] { return queued.empty() && writing.empty(); });
+	}
+
+	class component final : public component_interface
+	{
+	public:
+		void pre_destroy() override
+		{
+			// the writer empties the queue before leaving
+			stop_writer();
+		}
+	};
+}
+
+REGISTER_COMPONENT(gsc_saves::component)
@@ -0,0 +1,17 @@
+#pragma once
+#include "definitions/game.hpp"
+
+namespace gsc_saves
+{
+	std::string get_path(game::scriptInstance_t inst, const std::string& name);
+
+	// queue a saved json, the files are written by a background thread and the latest save of a name wins
+	void write(game::scriptInstance_t inst, const std::string& name, std::string data);
+	void remove(game::scriptInstance_t inst, const std::string& name);
+
+	// read a saved json, the queued saves are returned before the files
+	bool read(game::scriptInstance_t inst, const std::string& name, std::string* data);
+
+	// wait for the queued saves to be written
+	void flush();
+}
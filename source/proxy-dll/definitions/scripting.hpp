@@ -434,6 +434,26 @@ namespace game
 			{
 				return get_strings(start) + strings_count;
 			}
+
+			inline GSC_ACTS_LINES* get_lines(byte* start)
+			{
+				return reinterpret_cast<GSC_ACTS_LINES*>(start + lines_offset);
+			}
+
+			inline GSC_ACTS_LINES* get_lines_end(byte* start)
+			{
+				return get_lines(start) + lines_count;
+			}
+
+			inline GSC_ACTS_FILES* get_files(byte* start)
+			{
+				return reinterpret_cast<GSC_ACTS_FILES*>(start + files_offset);
+			}
+
+			inline GSC_ACTS_FILES* get_files_end(byte* start)
+			{
+				return get_files(start) + files_count;
+			}
 		};
 	}
 }
\ No newline at end of file
@@ -96,74 +96,107 @@ namespace demonware
 		if (bits == 0) return false;
 		if ((this->current_bit_ + bits) > (this->buffer_.size() * 8)) return false;
 
-		int cur_byte = this->current_bit_ >> 3;
-		auto cur_out = 0;
+		const auto* bytes = reinterpret_cast<const unsigned char*>(this->buffer_.data());
+		auto* output_bytes = static_cast<unsigned char*>(output);
 
-		const char* bytes = this->buffer_.data();
-		const auto output_bytes = static_cast<unsigned char*>(output);
-
-		while (bits > 0)
+		if ((this->current_bit_ & 7) == 0)
 		{
-			const int min_bit = (bits < 8) ? bits : 8;
-			const auto this_byte = bytes[cur_byte++] & 0xFF;
-			const int remain = this->current_bit_ & 7;
+			// byte aligned, whole bytes can be copied as is
+			const auto whole_bytes = bits >> 3;
+			std::memcpy(output_bytes, bytes + (this->current_bit_ >> 3), whole_bytes);
+			this->current_bit_ += whole_bytes << 3;
 
-			if ((min_bit + remain) <= 8)
-			{
-				output_bytes[cur_out] = BYTE((0xFF >> (8 - min_bit)) & (this_byte >> remain));
-			}
-			else
+			if (bits & 7)
 			{
-				output_bytes[cur_out] = BYTE(
-					(0xFF >> (8 - min_bit)) & (bytes[cur_byte] << (8 - remain)) | (this_byte >> remain));
+				output_bytes[whole_bytes] = BYTE(bytes[this->current_bit_ >> 3] & (0xFF >> (8 - (bits & 7))));
+				this->current_bit_ += bits & 7;
 			}
 
-			cur_out++;
-			this->current_bit_ += min_bit;
-			bits -= min_bit;
+			return true;
+		}
+
+		while (bits > 0)
+		{
+			const auto count = std::min(bits, chunk_bits);
+			const auto shift = this->current_bit_ & 7;
+
+			uint64_t word = 0;
+			std::memcpy(&word, bytes + (this->current_bit_ >> 3), (shift + count + 7) >> 3);
+			word = (word >> shift) & (~0ull >> (64 - count));
+
+			std::memcpy(output_bytes, &word, (count + 7) >> 3);
+
+			output_bytes += chunk_bits >> 3;
+			this->current_bit_ += count;
+			bits -= count;
 		}
 
 		return true;
 	}
 
-	bool bit_buffer::write(const unsigned int bits, const void* data)
+	bool bit_buffer::write(unsigned int bits, const void* data)
 	{
 		if (bits == 0) return false;
-		this->buffer_.resize(this->buffer_.size() + (bits >> 3) + 1);
+		this->grow(this->current_bit_ + bits);
 
-		int bit = bits;
-		const auto bytes = const_cast<char*>(this->buffer_.data());
+		auto* bytes = reinterpret_cast<unsigned char*>(this->buffer_.data());
 		const auto* input_bytes = static_cast<const unsigned char*>(data);
 
-		while (bit > 0)
+		if ((this->current_bit_ & 7) == 0)
 		{
-			const int bit_pos = this->current_bit_ & 7;
-			auto rem_bit = 8 - bit_pos;
-			const auto this_write = (bit < rem_bit) ? bit : rem_bit;
+			// byte aligned, whole bytes can be copied as is
+			const auto whole_bytes = bits >> 3;
+			std::memcpy(bytes + (this->current_bit_ >> 3), input_bytes, whole_bytes);
+			this->current_bit_ += whole_bytes << 3;
 
-			const BYTE mask = ((0xFF >> rem_bit) | (0xFF << (bit_pos + this_write)));
-			const int byte_pos = this->current_bit_ >> 3;
+			if (bits & 7)
+			{
+				const BYTE mask = BYTE(0xFF << (bits & 7));
+				auto& out_byte = bytes[this->current_bit_ >> 3];
+				out_byte = BYTE((out_byte & mask) | (input_bytes[whole_bytes] & ~mask));
+				this->current_bit_ += bits & 7;
+			}
 
-			const BYTE temp_byte = (mask & bytes[byte_pos]);
-			const BYTE this_bit = ((bits - bit) & 7);
-			const auto this_byte = (bits - bit) >> 3;
+			return true;
+		}
 
-			auto this_data = input_bytes[this_byte];
+		while (bits > 0)
+		{
+			const auto count = std::min(bits, chunk_bits);
+			const auto shift = this->current_bit_ & 7;
+			const auto out_size = (shift + count + 7) >> 3;
 
-			const auto next_byte = (((bits - 1) >> 3) > this_byte) ? input_bytes[this_byte + 1] : 0;
+			uint64_t value = 0;
+			std::memcpy(&value, input_bytes, (count + 7) >> 3);
 
-			this_data = BYTE((next_byte << (8 - this_bit)) | (this_data >> this_bit));
+			const auto value_mask = (~0ull >> (64 - count)) << shift;
 
-			const BYTE out_byte = (~mask & (this_data << bit_pos) | temp_byte);
-			bytes[byte_pos] = out_byte;
+			uint64_t word = 0;
+			std::memcpy(&word, bytes + (this->current_bit_ >> 3), out_size);
+			word = (word & ~value_mask) | ((value << shift) & value_mask);
+			std::memcpy(bytes + (this->current_bit_ >> 3), &word, out_size);
 
-			this->current_bit_ += this_write;
-			bit -= this_write;
+			input_bytes += chunk_bits >> 3;
+			this->current_bit_ += count;
+			bits -= count;
 		}
 
 		return true;
 	}
 
+	void bit_buffer::grow(const unsigned int bits)
+	{
+		const size_t required = (bits + 7) >> 3;
+		if (required <= this->buffer_.size()) return;
+
+		if (required > this->buffer_.capacity())
+		{
+			this->buffer_.reserve(std::max(required, this->buffer_.capacity() * 2));
+		}
+
+		this->buffer_.resize(required);
+	}
+
 	void bit_buffer::set_use_data_types(const bool use_data_types)
 	{
 		this->use_data_types_ = use_data_types;
@@ -33,8 +33,13 @@ namespace demonware
 		std::string& get_buffer();
 
 	private:
+		// bits moved per word operation, a chunk plus its bit offset always fits in 64 bits
+		static constexpr unsigned int chunk_bits = 56;
+
 		std::string buffer_{};
 		unsigned int current_bit_ = 0;
 		bool use_data_types_ = true;
+
+		void grow(unsigned int bits);
 	};
 }
@@ -80,20 +80,21 @@ namespace demonware
 	{
 		if (!this->read_data_type(16)) return false;
 
+		const auto* end = std::memchr(this->buffer_.data() + this->current_byte_, '\0', this->buffer_.size() - this->current_byte_);
+		if (!end) return false;
+
 		*output = const_cast<char*>(this->buffer_.data()) + this->current_byte_;
-		this->current_byte_ += strlen(*output) + 1;
+		this->current_byte_ = static_cast<const char*>(end) - this->buffer_.data() + 1;
 
 		return true;
 	}
 
 	bool byte_buffer::read_string(char* output, const int length)
 	{
-		if (!this->read_data_type(16)) return false;
+		char* data;
+		if (!this->read_string(&data)) return false;
 
-		strcpy_s(output, length, const_cast<char*>(this->buffer_.data()) + this->current_byte_);
-		this->current_byte_ += strlen(output) + 1;
-
-		return true;
+		return strcpy_s(output, length, data) == 0;
 	}
 
 	bool byte_buffer::read_blob(std::string* output)
@@ -188,7 +189,7 @@ namespace demonware
 		this->set_use_data_types(true);
 
 		if (element_count) *element_count = num_elements;
-		if (element_size) *element_size = array_size / num_elements;
+		if (element_size) *element_size = num_elements ? array_size / num_elements : 0;
 
 		this->set_use_data_types(using_types);
 		return true;
@@ -337,6 +338,39 @@ namespace demonware
 		return this->write(static_cast<int>(data.size()), data.data());
 	}
 
+	bool byte_buffer::write_prefix(const int bytes, const void* data)
+	{
+		if (bytes < 0 || static_cast<size_t>(bytes) > this->prefix_) return false;
+
+		this->prefix_ -= bytes;
+		std::memcpy(this->buffer_.data() + this->prefix_, data, bytes);
+
+		return true;
+	}
+
+	char* byte_buffer::append(const size_t bytes)
+	{
+		const auto offset = this->buffer_.size();
+		this->buffer_.resize(offset + bytes);
+		this->current_byte_ += bytes;
+
+		return this->buffer_.data() + offset;
+	}
+
+	void byte_buffer::reserve(const size_t bytes)
+	{
+		this->buffer_.reserve(bytes);
+	}
+
+	void byte_buffer::reserve_prefix(const size_t bytes)
+	{
+		if (!this->buffer_.empty()) return;
+
+		this->buffer_.resize(bytes);
+		this->current_byte_ = bytes;
+		this->prefix_ = bytes;
+	}
+
 	void byte_buffer::set_use_data_types(const bool use_data_types)
 	{
 		this->use_data_types_ = use_data_types;
@@ -344,7 +378,7 @@ namespace demonware
 
 	size_t byte_buffer::size() const
 	{
-		return this->buffer_.size();
+		return this->buffer_.size() - this->prefix_;
 	}
 
 	bool byte_buffer::is_using_data_types() const
@@ -354,6 +388,14 @@ namespace demonware
 
 	std::string& byte_buffer::get_buffer()
 	{
+		if (this->prefix_)
+		{
+			// drop whatever part of the reserved prefix was left unused
+			this->buffer_.erase(0, this->prefix_);
+			this->current_byte_ -= this->prefix_;
+			this->prefix_ = 0;
+		}
+
 		return this->buffer_;
 	}
 
@@ -42,6 +42,14 @@ namespace demonware
 			uint32_t ItemCount, itemSize;
 
 			if (!this->read_array_header(expected, &ItemCount, &itemSize)) return false;
+
+			// empty arrays are written without an element size
+			if (!ItemCount)
+			{
+				this->set_use_data_types(using_types);
+				return true;
+			}
+
 			if (itemSize != sizeof(T)) return false;
 
 			for (size_t i = 0; i < ItemCount; i++)
@@ -66,6 +74,14 @@ namespace demonware
 			uint32_t ItemCount, itemSize;
 
 			if (!this->read_array_header(expected, &ItemCount, &itemSize)) return false;
+
+			// empty arrays are written without an element size
+			if (!ItemCount)
+			{
+				this->set_use_data_types(using_types);
+				return true;
+			}
+
 			if (itemSize != sizeof(T)) return false;
 
 			for (size_t i = 0; i < ItemCount / 2; i++)
@@ -145,6 +161,22 @@ namespace demonware
 		bool write(int bytes, const void* data);
 		bool write(const std::string& data);
 
+		// fills the space set aside with reserve_prefix, back to front
+		bool write_prefix(int bytes, const void* data);
+
+		template <typename T>
+		bool write_prefix(const T& data)
+		{
+			static_assert(std::is_trivially_copyable_v<T>, "prefix values must be trivially copyable");
+			return this->write_prefix(sizeof(T), &data);
+		}
+
+		// grows the buffer by bytes and returns where they start, to be filled in place
+		char* append(size_t bytes);
+
+		void reserve(size_t bytes);
+		void reserve_prefix(size_t bytes);
+
 		void set_use_data_types(bool use_data_types);
 		size_t size() const;
 
@@ -158,6 +190,7 @@ namespace demonware
 	private:
 		std::string buffer_;
 		size_t current_byte_ = 0;
+		size_t prefix_ = 0;
 		bool use_data_types_ = true;
 	};
 }
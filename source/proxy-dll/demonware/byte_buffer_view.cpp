@@ -0,0 +1,203 @@
+#include <std_include.hpp>
+#include "byte_buffer_view.hpp"
+
+namespace demonware
+{
+	bool byte_buffer_view::read_string(std::string* output)
+	{
+		std::string_view out_data;
+		if (this->read_string(&out_data))
+		{
+			output->assign(out_data);
+			return true;
+		}
+
+		return false;
+	}
+
+	bool byte_buffer_view::read_string(const char** output)
+	{
+		std::string_view out_data;
+		if (this->read_string(&out_data))
+		{
+			*output = out_data.data();
+			return true;
+		}
+
+		return false;
+	}
+
+	bool byte_buffer_view::read_string(char* output, const int length)
+	{
+		std::string_view out_data;
+		if (!this->read_string(&out_data)) return false;
+		if (length <= 0 || out_data.size() >= static_cast<size_t>(length)) return false;
+
+		std::memcpy(output, out_data.data(), out_data.size());
+		output[out_data.size()] = '\0';
+
+		return true;
+	}
+
+	bool byte_buffer_view::read_string(std::string_view* output)
+	{
+		if (!this->read_data_type(16)) return false;
+
+		const auto* start = this->buffer_.data() + this->current_byte_;
+		const auto* end = static_cast<const char*>(std::memchr(start, '\0', this->remaining()));
+		if (!end) return false;
+
+		*output = std::string_view(start, end - start);
+		this->current_byte_ += output->size() + 1;
+
+		return true;
+	}
+
+	bool byte_buffer_view::read_blob(std::string* output)
+	{
+		std::string_view out_data;
+		if (this->read_blob(&out_data))
+		{
+			output->assign(out_data);
+			return true;
+		}
+
+		return false;
+	}
+
+	bool byte_buffer_view::read_blob(const char** output, int* length)
+	{
+		std::string_view out_data;
+		if (this->read_blob(&out_data))
+		{
+			*output = out_data.data();
+			*length = static_cast<int>(out_data.size());
+			return true;
+		}
+
+		return false;
+	}
+
+	bool byte_buffer_view::read_blob(std::string_view* output)
+	{
+		return this->read_sized(0x13, output);
+	}
+
+	bool byte_buffer_view::read_struct(std::string* output)
+	{
+		std::string_view out_data;
+		if (this->read_struct(&out_data))
+		{
+			output->assign(out_data);
+			return true;
+		}
+
+		return false;
+	}
+
+	bool byte_buffer_view::read_struct(const char** output, int* length)
+	{
+		std::string_view out_data;
+		if (this->read_struct(&out_data))
+		{
+			*output = out_data.data();
+			*length = static_cast<int>(out_data.size());
+			return true;
+		}
+
+		return false;
+	}
+
+	bool byte_buffer_view::read_struct(std::string_view* output)
+	{
+		return this->read_sized(0x17, output);
+	}
+
+	bool byte_buffer_view::read_sized(const char type, std::string_view* output)
+	{
+		if (!this->read_data_type(type)) return false;
+
+		unsigned int size;
+		if (!this->read_uint32(&size)) return false;
+		if (size > this->remaining()) return false;
+
+		*output = this->buffer_.substr(this->current_byte_, size);
+		this->current_byte_ += size;
+
+		return true;
+	}
+
+	bool byte_buffer_view::read_data_type(const char expected)
+	{
+		if (!this->use_data_types_) return true;
+
+		char type;
+		if (!this->read_fixed(&type)) return false;
+		return type == expected;
+	}
+
+	bool byte_buffer_view::read_array_header(const unsigned char expected
+		, unsigned int* element_count, unsigned int* element_size)
+	{
+		if (element_count) *element_count = 0;
+		if (element_size) *element_size = 0;
+
+		const auto using_types = this->is_using_data_types();
+		this->set_use_data_types(true);
+
+		if (!this->read_data_type(expected + 100)) return false;
+
+		uint32_t array_size, num_elements;
+		if (!this->read_uint32(&array_size)) return false;
+
+		this->set_use_data_types(false);
+		if (!this->read_uint32(&num_elements)) return false;
+		this->set_use_data_types(true);
+
+		if (element_count) *element_count = num_elements;
+		if (element_size) *element_size = num_elements ? array_size / num_elements : 0;
+
+		this->set_use_data_types(using_types);
+		return true;
+	}
+
+	bool byte_buffer_view::read(const int bytes, void* output)
+	{
+		if (bytes < 0 || static_cast<size_t>(bytes) > this->remaining()) return false;
+
+		std::memcpy(output, this->buffer_.data() + this->current_byte_, bytes);
+		this->current_byte_ += bytes;
+
+		return true;
+	}
+
+	void byte_buffer_view::set_use_data_types(const bool use_data_types)
+	{
+		this->use_data_types_ = use_data_types;
+	}
+
+	size_t byte_buffer_view::size() const
+	{
+		return this->buffer_.size();
+	}
+
+	bool byte_buffer_view::is_using_data_types() const
+	{
+		return use_data_types_;
+	}
+
+	std::string_view byte_buffer_view::get_buffer() const
+	{
+		return this->buffer_;
+	}
+
+	std::string_view byte_buffer_view::get_remaining() const
+	{
+		return this->buffer_.substr(this->current_byte_);
+	}
+
+	bool byte_buffer_view::has_more_data() const
+	{
+		return this->buffer_.size() > this->current_byte_;
+	}
+}
@@ -0,0 +1,159 @@
+#pragma once
+
+namespace demonware
+{
+	class byte_buffer_view final
+	{
+	public:
+		byte_buffer_view() = default;
+
+		explicit byte_buffer_view(const std::string_view buffer) : buffer_(buffer)
+		{
+		}
+
+		explicit byte_buffer_view(const std::string& buffer) : buffer_(buffer)
+		{
+		}
+
+		explicit byte_buffer_view(std::string&&) = delete;
+
+		explicit byte_buffer_view(const std::span<const char> buffer) : buffer_(buffer.data(), buffer.size())
+		{
+		}
+
+		bool read_bool(bool* output) { return this->read_typed(1, output); }
+		bool read_byte(char* output) { return this->read_typed(2, output); }
+		bool read_ubyte(unsigned char* output) { return this->read_typed(3, output); }
+		bool read_int16(short* output) { return this->read_typed(5, output); }
+		bool read_uint16(unsigned short* output) { return this->read_typed(6, output); }
+		bool read_int32(int* output) { return this->read_typed(7, output); }
+		bool read_uint32(unsigned int* output) { return this->read_typed(8, output); }
+		bool read_int64(__int64* output) { return this->read_typed(9, output); }
+		bool read_uint64(unsigned __int64* output) { return this->read_typed(10, output); }
+		bool read_float(float* output) { return this->read_typed(13, output); }
+		bool read_string(const char** output);
+		bool read_string(char* output, int length);
+		bool read_string(std::string_view* output);
+		bool read_string(std::string* output);
+		bool read_blob(const char** output, int* length);
+		bool read_blob(std::string_view* output);
+		bool read_blob(std::string* output);
+		bool read_struct(const char** output, int* length);
+		bool read_struct(std::string_view* output);
+		bool read_struct(std::string* output);
+		bool read_data_type(char expected);
+
+		bool read_array_header(const unsigned char expected
+			, unsigned int* element_count, unsigned int* element_size);
+
+		template <typename T>
+		bool read_array(const unsigned char expected, std::vector<T>* vec)
+		{
+			static_assert(std::is_trivially_copyable_v<T>, "array elements must be trivially copyable");
+
+			const auto using_types = this->is_using_data_types();
+			this->set_use_data_types(false);
+
+			uint32_t item_count, item_size;
+
+			if (!this->read_array_header(expected, &item_count, &item_size)) return false;
+
+			// empty arrays are written without an element size
+			if (!item_count)
+			{
+				this->set_use_data_types(using_types);
+				return true;
+			}
+
+			if (item_size != sizeof(T)) return false;
+			if (item_count > this->remaining() / sizeof(T)) return false;
+
+			const auto offset = vec->size();
+			vec->resize(offset + item_count);
+			std::memcpy(vec->data() + offset, this->buffer_.data() + this->current_byte_, item_count * sizeof(T));
+			this->current_byte_ += item_count * sizeof(T);
+
+			this->set_use_data_types(using_types);
+			return true;
+		}
+
+		template <typename T>
+		bool read_array(const unsigned char expected, std::map<T, T>* map)
+		{
+			const auto using_types = this->is_using_data_types();
+			this->set_use_data_types(false);
+
+			uint32_t item_count, item_size;
+
+			if (!this->read_array_header(expected, &item_count, &item_size)) return false;
+
+			// empty arrays are written without an element size
+			if (!item_count)
+			{
+				this->set_use_data_types(using_types);
+				return true;
+			}
+
+			if (item_size != sizeof(T)) return false;
+			if (item_count > this->remaining() / sizeof(T)) return false;
+
+			for (size_t i = 0; i < item_count / 2; i++)
+			{
+				T key{}, value{};
+
+				this->read_fixed(&key);
+				this->read_fixed(&value);
+
+				map->insert({ key, value });
+			}
+
+			this->set_use_data_types(using_types);
+			return true;
+		}
+
+		template <typename T>
+		bool read_fixed(T* output)
+		{
+			static_assert(std::is_trivially_copyable_v<T>, "fixed-width reads require a trivially copyable type");
+
+			if (sizeof(T) > this->remaining()) return false;
+
+			// constant size, the copy is lowered to a single (unaligned) load
+			std::memcpy(output, this->buffer_.data() + this->current_byte_, sizeof(T));
+			this->current_byte_ += sizeof(T);
+
+			return true;
+		}
+
+		bool read(int bytes, void* output);
+
+		void set_use_data_types(bool use_data_types);
+		size_t size() const;
+
+		bool is_using_data_types() const;
+
+		std::string_view get_buffer() const;
+		std::string_view get_remaining() const;
+
+		bool has_more_data() const;
+
+	private:
+		std::string_view buffer_{};
+		size_t current_byte_ = 0;
+		bool use_data_types_ = true;
+
+		size_t remaining() const
+		{
+			return this->buffer_.size() - this->current_byte_;
+		}
+
+		template <typename T>
+		bool read_typed(const char type, T* output)
+		{
+			if (!this->read_data_type(type)) return false;
+			return this->read_fixed(output);
+		}
+
+		bool read_sized(char type, std::string_view* output);
+	};
+}
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "byte_buffer.hpp"
+#include "serializer.hpp"
 
 namespace demonware
 {
@@ -16,6 +17,11 @@ namespace demonware
 		virtual void deserialize(byte_buffer*)
 		{
 		}
+
+		virtual size_t serialized_size(bool /*typed*/) const
+		{
+			return 0;
+		}
 	};
 
 	class bdStringResult final : public bdTaskResult
@@ -23,14 +29,24 @@ namespace demonware
 	public:
 		std::string content = "";
 
+		static constexpr auto fields()
+		{
+			return serializer::fields(serializer::string(&bdStringResult::content));
+		}
+
 		void serialize(byte_buffer* buffer) override
 		{
-			buffer->write_string(this->content);
+			serializer::write(*this, buffer);
 		}
 
 		void deserialize(byte_buffer* buffer) override
 		{
-			buffer->read_string(&this->content);
+			serializer::read(*this, buffer);
+		}
+
+		size_t serialized_size(const bool typed) const override
+		{
+			return serializer::size(*this, typed);
 		}
 	};
 
@@ -39,30 +55,50 @@ namespace demonware
 	public:
 		uint64_t value = 0;
 
+		static constexpr auto fields()
+		{
+			return serializer::fields(serializer::value(&bdUInt64Result::value));
+		}
+
 		void serialize(byte_buffer* buffer) override
 		{
-			buffer->write_uint64(this->value);
+			serializer::write(*this, buffer);
 		}
 
 		void deserialize(byte_buffer* buffer) override
 		{
-			buffer->read_uint64(&this->value);
+			serializer::read(*this, buffer);
+		}
+
+		size_t serialized_size(const bool typed) const override
+		{
+			return serializer::size(*this, typed);
 		}
 	};
-	
+
 	class bdBoolResult final : public bdTaskResult
 	{
 	public:
 		bool value = false;
 
+		static constexpr auto fields()
+		{
+			return serializer::fields(serializer::value(&bdBoolResult::value));
+		}
+
 		void serialize(byte_buffer* buffer) override
 		{
-			buffer->write_bool(this->value);
+			serializer::write(*this, buffer);
 		}
 
 		void deserialize(byte_buffer* buffer) override
 		{
-			buffer->read_bool(&this->value);
+			serializer::read(*this, buffer);
+		}
+
+		size_t serialized_size(const bool typed) const override
+		{
+			return serializer::size(*this, typed);
 		}
 	};
 
@@ -71,14 +107,24 @@ namespace demonware
 	public:
 		uint32_t unix_time = 0;
 
+		static constexpr auto fields()
+		{
+			return serializer::fields(serializer::value(&bdTimeStamp::unix_time));
+		}
+
 		void serialize(byte_buffer* buffer) override
 		{
-			buffer->write_uint32(this->unix_time);
+			serializer::write(*this, buffer);
 		}
 
 		void deserialize(byte_buffer* buffer) override
 		{
-			buffer->read_uint32(&this->unix_time);
+			serializer::read(*this, buffer);
+		}
+
+		size_t serialized_size(const bool typed) const override
+		{
+			return serializer::size(*this, typed);
 		}
 	};
 
@@ -94,28 +140,33 @@ namespace demonware
 		uint32_t asn = 0; // Autonomous System Number.
 		std::string timezone = "";
 
+		static constexpr auto fields()
+		{
+			return serializer::fields(
+				serializer::string(&bdDMLInfo::country_code),
+				serializer::string(&bdDMLInfo::country),
+				serializer::string(&bdDMLInfo::region),
+				serializer::string(&bdDMLInfo::city),
+				serializer::value(&bdDMLInfo::latitude),
+				serializer::value(&bdDMLInfo::longitude),
+				serializer::value(&bdDMLInfo::asn),
+				serializer::string(&bdDMLInfo::timezone)
+			);
+		}
+
 		void serialize(byte_buffer* buffer) override
 		{
-			buffer->write_string(this->country_code);
-			buffer->write_string(this->country);
-			buffer->write_string(this->region);
-			buffer->write_string(this->city);
-			buffer->write_float(this->latitude);
-			buffer->write_float(this->longitude);
-			buffer->write_uint32(this->asn);
-			buffer->write_string(this->timezone);
+			serializer::write(*this, buffer);
 		}
 
 		void deserialize(byte_buffer* buffer) override
 		{
-			buffer->read_string(&this->country_code);
-			buffer->read_string(&this->country);
-			buffer->read_string(&this->region);
-			buffer->read_string(&this->city);
-			buffer->read_float(&this->latitude);
-			buffer->read_float(&this->longitude);
-			buffer->read_uint32(&this->asn);
-			buffer->read_string(&this->timezone);
+			serializer::read(*this, buffer);
+		}
+
+		size_t serialized_size(const bool typed) const override
+		{
+			return serializer::size(*this, typed);
 		}
 	};
 
@@ -128,26 +179,30 @@ namespace demonware
 		uint32_t m_tier3 = 0;
 		uint32_t m_confidence = 0;
 
-		void serialize(byte_buffer* buffer) override
+		static constexpr auto fields()
 		{
-			bdDMLInfo::serialize(buffer);
+			return std::tuple_cat(bdDMLInfo::fields(), serializer::fields(
+				serializer::value(&bdDMLHierarchicalInfo::m_tier0),
+				serializer::value(&bdDMLHierarchicalInfo::m_tier1),
+				serializer::value(&bdDMLHierarchicalInfo::m_tier2),
+				serializer::value(&bdDMLHierarchicalInfo::m_tier3),
+				serializer::value(&bdDMLHierarchicalInfo::m_confidence)
+			));
+		}
 
-			buffer->write_uint32(this->m_tier0);
-			buffer->write_uint32(this->m_tier1);
-			buffer->write_uint32(this->m_tier2);
-			buffer->write_uint32(this->m_tier3);
-			buffer->write_uint32(this->m_confidence);
+		void serialize(byte_buffer* buffer) override
+		{
+			serializer::write(*this, buffer);
 		}
 
 		void deserialize(byte_buffer* buffer) override
 		{
-			bdDMLInfo::deserialize(buffer);
+			serializer::read(*this, buffer);
+		}
 
-			buffer->read_uint32(&this->m_tier0);
-			buffer->read_uint32(&this->m_tier1);
-			buffer->read_uint32(&this->m_tier2);
-			buffer->read_uint32(&this->m_tier3);
-			buffer->read_uint32(&this->m_confidence);
+		size_t serialized_size(const bool typed) const override
+		{
+			return serializer::size(*this, typed);
 		}
 	};
 
@@ -158,21 +213,31 @@ namespace demonware
 		int32_t m_VERSION = 0;
 		std::string m_ddl = "";
 
+		static constexpr auto fields()
+		{
+			return serializer::fields(
+				serializer::value(&bdPublicProfileInfo::m_entityID),
+				serializer::value(&bdPublicProfileInfo::m_VERSION),
+				serializer::blob(&bdPublicProfileInfo::m_ddl)
+			);
+		}
+
 		void serialize(byte_buffer* buffer) override
 		{
-			buffer->write_uint64(this->m_entityID);
-			buffer->write_int32(this->m_VERSION);
-			buffer->write_blob(this->m_ddl);
+			serializer::write(*this, buffer);
 		}
 
 		void deserialize(byte_buffer* buffer) override
 		{
-			buffer->read_uint64(&this->m_entityID);
-			buffer->read_int32(&this->m_VERSION);
-			buffer->read_blob(&this->m_ddl);
+			serializer::read(*this, buffer);
+		}
+
+		size_t serialized_size(const bool typed) const override
+		{
+			return serializer::size(*this, typed);
 		}
 	};
-	
+
 	class bdFileMetaData final : public bdTaskResult
 	{
 	public:
@@ -192,23 +257,40 @@ namespace demonware
 		uint32_t m_numCopiesMade = 0;
 		uint64_t m_originID = 0;
 
+		static constexpr auto fields()
+		{
+			return serializer::fields(
+				serializer::value(&bdFileMetaData::m_fileID),
+				serializer::value(&bdFileMetaData::m_createTime),
+				serializer::value(&bdFileMetaData::m_modifedTime),
+				serializer::value(&bdFileMetaData::m_fileSize),
+				serializer::value(&bdFileMetaData::m_ownerID),
+				serializer::string(&bdFileMetaData::m_ownerName),
+				serializer::value(&bdFileMetaData::m_fileSlot),
+				serializer::string(&bdFileMetaData::m_fileName),
+				serializer::string(&bdFileMetaData::m_url),
+				serializer::value(&bdFileMetaData::m_category),
+				serializer::blob(&bdFileMetaData::m_metaData),
+				serializer::value(&bdFileMetaData::m_summaryFileSize),
+				serializer::tags(&bdFileMetaData::m_tags),
+				serializer::value(&bdFileMetaData::m_numCopiesMade),
+				serializer::value(&bdFileMetaData::m_originID)
+			);
+		}
+
 		void serialize(byte_buffer* buffer) override
 		{
-			buffer->write_uint64(this->m_fileID);
-			buffer->write_uint32(this->m_createTime);
-			buffer->write_uint32(this->m_modifedTime);
-			buffer->write_uint32(this->m_fileSize);
-			buffer->write_uint64(this->m_ownerID);
-			buffer->write_string(this->m_ownerName);
-			buffer->write_uint16(this->m_fileSlot);
-			buffer->write_string(this->m_fileName);
-			buffer->write_string(this->m_url);
-			buffer->write_uint16(this->m_category);
-			buffer->write_blob(this->m_metaData);
-			buffer->write_uint32(this->m_summaryFileSize);
-			buffer->write_array(10, m_tags);
-			buffer->write_uint32(this->m_numCopiesMade);
-			buffer->write_uint64(this->m_originID);
+			serializer::write(*this, buffer);
+		}
+
+		void deserialize(byte_buffer* buffer) override
+		{
+			serializer::read(*this, buffer);
+		}
+
+		size_t serialized_size(const bool typed) const override
+		{
+			return serializer::size(*this, typed);
 		}
 	};
 
@@ -220,36 +302,115 @@ namespace demonware
 		std::string m_serverIndex = "";
 		uint64_t m_fileID = 0;
 
+		static constexpr auto fields()
+		{
+			return serializer::fields(
+				serializer::string(&bdURL::m_url),
+				serializer::value(&bdURL::m_serverType),
+				serializer::string(&bdURL::m_serverIndex),
+				serializer::value(&bdURL::m_fileID)
+			);
+		}
+
 		void serialize(byte_buffer* buffer) override
 		{
-			buffer->write_string(this->m_url);
-			buffer->write_uint16(this->m_serverType);
-			buffer->write_string(this->m_serverIndex);
-			buffer->write_uint64(this->m_fileID);
+			serializer::write(*this, buffer);
 		}
 
 		void deserialize(byte_buffer* buffer) override
 		{
-			buffer->read_string(&this->m_url);
-			buffer->read_uint16(&this->m_serverType);
-			buffer->read_string(&this->m_serverIndex);
-			buffer->read_uint64(&this->m_fileID);
+			serializer::read(*this, buffer);
+		}
+
+		size_t serialized_size(const bool typed) const override
+		{
+			return serializer::size(*this, typed);
+		}
+	};
+
+	class bdKeyValuePair final : public bdTaskResult
+	{
+	public:
+		uint16_t m_index = 0;
+		int64_t m_value = 0;
+
+		static constexpr auto fields()
+		{
+			return serializer::fields(
+				serializer::value(&bdKeyValuePair::m_index),
+				serializer::value(&bdKeyValuePair::m_value));
+		}
+
+		void serialize(byte_buffer* buffer) override
+		{
+			serializer::write(*this, buffer);
+		}
+
+		void deserialize(byte_buffer* buffer) override
+		{
+			serializer::read(*this, buffer);
+		}
+
+		size_t serialized_size(const bool typed) const override
+		{
+			return serializer::size(*this, typed);
 		}
 	};
-		
+
+	class bdEntityIDKeyValuePair final : public bdTaskResult
+	{
+	public:
+		uint64_t m_entityID = 0;
+		uint16_t m_index = 0;
+		int64_t m_value = 0;
+
+		static constexpr auto fields()
+		{
+			return serializer::fields(
+				serializer::value(&bdEntityIDKeyValuePair::m_entityID),
+				serializer::value(&bdEntityIDKeyValuePair::m_index),
+				serializer::value(&bdEntityIDKeyValuePair::m_value));
+		}
+
+		void serialize(byte_buffer* buffer) override
+		{
+			serializer::write(*this, buffer);
+		}
+
+		void deserialize(byte_buffer* buffer) override
+		{
+			serializer::read(*this, buffer);
+		}
+
+		size_t serialized_size(const bool typed) const override
+		{
+			return serializer::size(*this, typed);
+		}
+	};
+
 	class bdStructedDataBuffer final : public bdTaskResult
 	{
 	public:
 		std::string structed_data_protobuffer = "";
 
+		static constexpr auto fields()
+		{
+			return serializer::fields(serializer::structure(&bdStructedDataBuffer::structed_data_protobuffer));
+		}
+
 		void serialize(byte_buffer* buffer) override
 		{
-			buffer->write_struct(this->structed_data_protobuffer);
+			serializer::write(*this, buffer);
 		}
 
 		void deserialize(byte_buffer* buffer) override
 		{
-			buffer->read_struct(&this->structed_data_protobuffer);
+			serializer::read(*this, buffer);
+		}
+
+		size_t serialized_size(const bool typed) const override
+		{
+			return serializer::size(*this, typed);
 		}
 	};
 }
@@ -1,5 +1,7 @@
 #include <std_include.hpp>
 #include "fileshare.hpp"
+#include "byte_buffer_view.hpp"
+#include "record_log.hpp"
 #include "component/platform.hpp"
 
 #include <utilities/io.hpp>
@@ -245,22 +247,334 @@ namespace demonware::fileshare
 		return utilities::io::write_file(path, this->SerializeMetaJSON());
 	}
 
-	std::vector<uint64_t> fileshare_list_demo_ids()
+	namespace
 	{
-		std::vector<uint64_t> results;
+		enum record_type : uint8_t
+		{
+			RECORD_PUT = 1,
+			RECORD_REMOVE = 2,
+		};
 
-		std::vector<std::string> files = utilities::io::list_files(get_fileshare_directory());
+		std::string serialize_put(const FileMetadata& metadata)
+		{
+			byte_buffer buffer;
+			buffer.set_use_data_types(false);
+
+			buffer.write_ubyte(RECORD_PUT);
+			buffer.write_int32(metadata.state);
+			buffer.write_uint16(metadata.category);
+			buffer.write_blob(metadata.ioFileName);
+			buffer.write_uint32(metadata.ioFileSize);
+			buffer.write_uint64(metadata.file.id);
+			buffer.write_blob(metadata.file.name);
+			buffer.write_uint32(metadata.file.size);
+			buffer.write_uint32(metadata.file.timestamp);
+			buffer.write_uint64(metadata.author.xuid);
+			buffer.write_blob(metadata.author.name);
+			buffer.write_blob(metadata.ddlMetadata);
+			buffer.write_array(10, metadata.tags);
+
+			return record_log::frame(buffer.get_buffer());
+		}
 
-		for (auto& file : files)
+		std::string serialize_remove(const uint64_t id)
 		{
-			std::string rawName = utilities::io::file_stem(file);
+			byte_buffer buffer;
+			buffer.set_use_data_types(false);
 
-			if (utilities::string::is_integer(rawName)
-				&& utilities::string::ends_with(file, ".demo")
-				&& utilities::io::file_exists(get_metadata_path(rawName)))
+			buffer.write_ubyte(RECORD_REMOVE);
+			buffer.write_uint64(id);
+
+			return record_log::frame(buffer.get_buffer());
+		}
+
+		bool deserialize_put(byte_buffer_view* buffer, FileMetadata* metadata)
+		{
+			int state{};
+			uint16_t category{};
+
+			const auto result = buffer->read_int32(&state)
+				&& buffer->read_uint16(&category)
+				&& buffer->read_blob(&metadata->ioFileName)
+				&& buffer->read_uint32(&metadata->ioFileSize)
+				&& buffer->read_uint64(&metadata->file.id)
+				&& buffer->read_blob(&metadata->file.name)
+				&& buffer->read_uint32(&metadata->file.size)
+				&& buffer->read_uint32(&metadata->file.timestamp)
+				&& buffer->read_uint64(&metadata->author.xuid)
+				&& buffer->read_blob(&metadata->author.name)
+				&& buffer->read_blob(&metadata->ddlMetadata)
+				&& buffer->read_array(10, &metadata->tags);
+
+			metadata->state = static_cast<FileMetadata::file_state>(state);
+			metadata->category = static_cast<fileshareCategory_e>(category);
+
+			return result;
+		}
+
+		bool is_stored(const FileMetadata& metadata)
+		{
+			return metadata.state == FileMetadata::FILE_STATE_UPLOADED || metadata.state == FileMetadata::FILE_STATE_DESCRIBED;
+		}
+	}
+
+	catalog::catalog(std::string directory)
+		: directory_(std::move(directory)), log_path_(std::format("{}/catalog.bin", this->directory_))
+	{
+		this->load();
+		this->reconcile();
+	}
+
+	std::optional<FileMetadata> catalog::find(const uint64_t id) const
+	{
+		std::lock_guard<std::mutex> _(this->mutex_);
+
+		const auto entry = this->files_.find(id);
+		if (entry == this->files_.end()) return {};
+
+		return entry->second;
+	}
+
+	std::vector<FileMetadata> catalog::query(const catalog_query& query) const
+	{
+		std::vector<FileMetadata> results{};
+
+		std::lock_guard<std::mutex> _(this->mutex_);
+
+		// walk the narrowest index, whatever it doesn't cover is filtered on the way
+		static const std::set<time_key> empty{};
+		const std::set<time_key>* index = &this->by_time_;
+
+		if (query.author)
+		{
+			const auto entry = this->by_author_.find(*query.author);
+			index = entry == this->by_author_.end() ? &empty : &entry->second;
+		}
+		else if (query.category)
+		{
+			const auto entry = this->by_category_.find(static_cast<uint16_t>(*query.category));
+			index = entry == this->by_category_.end() ? &empty : &entry->second;
+		}
+
+		auto skip = query.offset;
+		for (auto key = index->rbegin(); key != index->rend() && results.size() < query.limit; ++key)
+		{
+			const auto& metadata = this->files_.at(key->second);
+
+			if (query.category && metadata.category != *query.category) continue;
+			if (query.author && metadata.author.xuid != *query.author) continue;
+			if (metadata.state < query.min_state) continue;
+
+			if (skip)
+			{
+				skip--;
+				continue;
+			}
+
+			results.push_back(metadata);
+		}
+
+		return results;
+	}
+
+	bool catalog::put(const FileMetadata& metadata)
+	{
+		std::lock_guard<std::mutex> _(this->mutex_);
+
+		if (!this->append(serialize_put(metadata))) return false;
+
+		const auto entry = this->files_.find(metadata.file.id);
+		if (entry != this->files_.end()) this->unindex(entry->second);
+
+		this->files_[metadata.file.id] = metadata;
+		this->index(metadata);
+
+		this->compact_if_needed();
+		return true;
+	}
+
+	bool catalog::remove(const uint64_t id)
+	{
+		std::lock_guard<std::mutex> _(this->mutex_);
+
+		const auto entry = this->files_.find(id);
+		if (entry == this->files_.end()) return false;
+
+		if (!this->append(serialize_remove(id))) return false;
+
+		this->unindex(entry->second);
+		this->files_.erase(entry);
+
+		this->compact_if_needed();
+		return true;
+	}
+
+	void catalog::load()
+	{
+		std::string log{};
+		if (!utilities::io::read_file(this->log_path_, &log)) return;
+
+		const auto intact = record_log::replay(log, [&](const std::string_view record)
+		{
+			byte_buffer_view buffer(record);
+			buffer.set_use_data_types(false);
+
+			// only the records that parse are counted, the others are gone after the next compaction
+			unsigned char type{};
+			if (!buffer.read_ubyte(&type)) return;
+
+			if (type == RECORD_PUT)
 			{
-				results.push_back(std::stoull(rawName));
+				FileMetadata metadata{};
+				if (!deserialize_put(&buffer, &metadata)) return;
+
+				const auto entry = this->files_.find(metadata.file.id);
+				if (entry != this->files_.end()) this->unindex(entry->second);
+
+				this->index(metadata);
+				this->files_[metadata.file.id] = std::move(metadata);
+				this->log_records_++;
 			}
+			else if (type == RECORD_REMOVE)
+			{
+				uint64_t id{};
+				if (!buffer.read_uint64(&id)) return;
+
+				this->log_records_++;
+
+				const auto entry = this->files_.find(id);
+				if (entry == this->files_.end()) return;
+
+				this->unindex(entry->second);
+				this->files_.erase(entry);
+			}
+		});
+
+		// a torn write at the end is dropped, everything before it is kept
+		if (intact != log.size())
+		{
+			logger::write(logger::LOG_TYPE_DEBUG, "[DW]: [fileshare]: dropping %zu damaged bytes from the catalog\n", log.size() - intact);
+			this->compact();
+		}
+	}
+
+	void catalog::reconcile()
+	{
+		std::unordered_set<std::string> files{};
+		std::vector<std::filesystem::path> metadata_files{};
+
+		std::error_code ec{};
+		for (const auto& entry : std::filesystem::directory_iterator(this->directory_, ec))
+		{
+			if (entry.is_directory(ec)) continue;
+
+			const auto& path = entry.path();
+			if (path.extension() == ".metadata") metadata_files.push_back(path);
+			else files.insert(path.filename().string());
+		}
+
+		std::lock_guard<std::mutex> _(this->mutex_);
+
+		// records whose data went missing behind our back
+		std::vector<uint64_t> missing{};
+		for (const auto& [id, metadata] : this->files_)
+		{
+			if (is_stored(metadata) && !files.contains(utilities::io::file_name(metadata.ioFileName))) missing.push_back(id);
+		}
+
+		for (const auto id : missing)
+		{
+			auto& metadata = this->files_[id];
+			if (!this->append(serialize_remove(id))) continue;
+
+			this->unindex(metadata);
+			this->files_.erase(id);
+		}
+
+		// loose .metadata files from before the catalog existed
+		for (const auto& path : metadata_files)
+		{
+			const auto stem = path.stem().string();
+			if (!utilities::string::is_integer(stem) || this->files_.contains(std::stoull(stem))) continue;
+
+			FileMetadata metadata{};
+			if (!metadata.ReadMetaDataJson(path.generic_string())) continue;
+			if (is_stored(metadata) && !files.contains(utilities::io::file_name(metadata.ioFileName))) continue;
+			if (!this->append(serialize_put(metadata))) continue;
+
+			this->index(metadata);
+			this->files_[metadata.file.id] = std::move(metadata);
+		}
+
+		this->compact_if_needed();
+	}
+
+	void catalog::compact()
+	{
+		std::string log{};
+		for (const auto& [id, metadata] : this->files_)
+		{
+			log.append(serialize_put(metadata));
+		}
+
+		if (record_log::rewrite(this->log_path_, log))
+		{
+			this->log_records_ = this->files_.size();
+		}
+	}
+
+	bool catalog::append(const std::string& record)
+	{
+		if (!utilities::io::write_file(this->log_path_, record, true)) return false;
+
+		this->log_records_++;
+		return true;
+	}
+
+	void catalog::compact_if_needed()
+	{
+		// superseded records are only dropped once they clearly outnumber live ones
+		if (this->log_records_ > this->files_.size() * 2 + 64)
+		{
+			this->compact();
+		}
+	}
+
+	void catalog::index(const FileMetadata& metadata)
+	{
+		const time_key key{ metadata.file.timestamp, metadata.file.id };
+
+		this->by_time_.insert(key);
+		this->by_category_[static_cast<uint16_t>(metadata.category)].insert(key);
+		this->by_author_[metadata.author.xuid].insert(key);
+	}
+
+	void catalog::unindex(const FileMetadata& metadata)
+	{
+		const time_key key{ metadata.file.timestamp, metadata.file.id };
+
+		this->by_time_.erase(key);
+		this->by_category_[static_cast<uint16_t>(metadata.category)].erase(key);
+		this->by_author_[metadata.author.xuid].erase(key);
+	}
+
+	catalog& get_catalog()
+	{
+		static catalog instance{ get_fileshare_directory() };
+		return instance;
+	}
+
+	std::vector<uint64_t> fileshare_list_demo_ids()
+	{
+		std::vector<uint64_t> results;
+
+		catalog_query query{};
+		query.category = FILESHARE_CATEGORY_FILM;
+		query.min_state = FileMetadata::FILE_STATE_UPLOADED;
+
+		for (const auto& metadata : get_catalog().query(query))
+		{
+			results.push_back(metadata.file.id);
 		}
 
 		return results;
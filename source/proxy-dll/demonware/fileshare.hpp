@@ -98,5 +98,55 @@ namespace demonware::fileshare
         bool ParseMetaJSON(const std::string& input);
     };
 
+    struct catalog_query
+    {
+        std::optional<fileshareCategory_e> category{};
+        std::optional<uint64_t> author{};
+        FileMetadata::file_state min_state = FileMetadata::FILE_STATE_UNKNOWN;
+
+        size_t offset = 0;
+        size_t limit = std::numeric_limits<size_t>::max();
+    };
+
+    // every FileMetadata record of the fileshare directory in one append-only log,
+    // indexed in memory by file id, category, author and timestamp
+    class catalog final
+    {
+    public:
+        explicit catalog(std::string directory);
+
+        std::optional<FileMetadata> find(uint64_t id) const;
+        // newest first
+        std::vector<FileMetadata> query(const catalog_query& query) const;
+
+        bool put(const FileMetadata& metadata);
+        bool remove(uint64_t id);
+
+    private:
+        using time_key = std::pair<uint32_t, uint64_t>;
+
+        std::string directory_;
+        std::string log_path_;
+
+        mutable std::mutex mutex_{};
+        std::unordered_map<uint64_t, FileMetadata> files_{};
+        std::set<time_key> by_time_{};
+        std::unordered_map<uint16_t, std::set<time_key>> by_category_{};
+        std::unordered_map<uint64_t, std::set<time_key>> by_author_{};
+
+        size_t log_records_ = 0;
+
+        void load();
+        void reconcile();
+        void compact();
+        void compact_if_needed();
+
+        bool append(const std::string& record);
+        void index(const FileMetadata& metadata);
+        void unindex(const FileMetadata& metadata);
+    };
+
+    catalog& get_catalog();
+
     std::vector<uint64_t> fileshare_list_demo_ids();
 }
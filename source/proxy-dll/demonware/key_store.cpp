@@ -0,0 +1,189 @@
+#include <std_include.hpp>
+#include "key_store.hpp"
+
+#include "byte_buffer.hpp"
+#include "byte_buffer_view.hpp"
+#include "record_log.hpp"
+#include "component/platform.hpp"
+
+#include <utilities/io.hpp>
+
+namespace demonware
+{
+	namespace
+	{
+		std::string serialize_entries(const std::vector<key_store::entry>& entries)
+		{
+			byte_buffer buffer;
+			buffer.set_use_data_types(false);
+			buffer.reserve(4 + entries.size() * 20);
+
+			buffer.write_uint32(static_cast<uint32_t>(entries.size()));
+			for (const auto& entry : entries)
+			{
+				buffer.write_uint64(entry.key.entity_id);
+				buffer.write_uint16(entry.key.category);
+				buffer.write_uint16(entry.key.index);
+				buffer.write_int64(entry.value);
+			}
+
+			return record_log::frame(buffer.get_buffer());
+		}
+
+		template <typename F>
+		void deserialize_entries(const std::string_view record, F&& handler)
+		{
+			byte_buffer_view buffer(record);
+			buffer.set_use_data_types(false);
+
+			uint32_t count{};
+			if (!buffer.read_uint32(&count)) return;
+
+			for (uint32_t i = 0; i < count; i++)
+			{
+				key_store::entry entry{};
+				if (!buffer.read_uint64(&entry.key.entity_id)
+					|| !buffer.read_uint16(&entry.key.category)
+					|| !buffer.read_uint16(&entry.key.index)
+					|| !buffer.read_int64(&entry.value)) return;
+
+				handler(entry);
+			}
+		}
+
+		int64_t resolve(const std::optional<int64_t>& current, const key_store::update& update)
+		{
+			const auto value = update.target.value;
+			if (!current) return value;
+
+			switch (update.type)
+			{
+			case key_store::WRITE_ADD:
+				return *current + value;
+			case key_store::WRITE_MAX:
+				return std::max(*current, value);
+			case key_store::WRITE_MIN:
+				return std::min(*current, value);
+			default:
+				return value;
+			}
+		}
+	}
+
+	key_store::key_store(std::string path)
+		: snapshot_path_(path), log_path_(std::move(path) + ".wal")
+	{
+		this->load(this->snapshot_path_);
+		this->load(this->log_path_);
+
+		if (this->log_size_) this->compact();
+	}
+
+	std::optional<int64_t> key_store::read(const value_key& key) const
+	{
+		std::lock_guard<std::mutex> _(this->mutex_);
+
+		const auto value = this->values_.find(key);
+		if (value == this->values_.end()) return {};
+
+		return value->second;
+	}
+
+	std::vector<key_store::entry> key_store::read_all(const uint64_t entity_id, const uint16_t category) const
+	{
+		std::vector<entry> entries{};
+
+		std::lock_guard<std::mutex> _(this->mutex_);
+
+		const auto begin = this->values_.lower_bound({ entity_id, category, 0 });
+		for (auto value = begin; value != this->values_.end(); ++value)
+		{
+			if (value->first.entity_id != entity_id || value->first.category != category) break;
+			entries.push_back({ value->first, value->second });
+		}
+
+		return entries;
+	}
+
+	bool key_store::write(const std::vector<update>& updates)
+	{
+		if (updates.empty()) return true;
+
+		std::lock_guard<std::mutex> _(this->mutex_);
+
+		// resolve against the current values first, the log only ever holds final values
+		std::vector<entry> entries{};
+		entries.reserve(updates.size());
+
+		std::map<value_key, int64_t> pending{};
+		for (const auto& update : updates)
+		{
+			const auto& key = update.target.key;
+			std::optional<int64_t> current{};
+
+			if (const auto value = pending.find(key); value != pending.end()) current = value->second;
+			else if (const auto stored = this->values_.find(key); stored != this->values_.end()) current = stored->second;
+
+			const auto value = resolve(current, update);
+			pending[key] = value;
+			entries.push_back({ key, value });
+		}
+
+		const auto record = serialize_entries(entries);
+		if (!utilities::io::write_file(this->log_path_, record, true)) return false;
+
+		for (const auto& [key, value] : pending)
+		{
+			this->values_[key] = value;
+		}
+
+		this->log_size_ += record.size();
+		if (this->log_size_ > compact_threshold) this->compact();
+
+		return true;
+	}
+
+	void key_store::load(const std::string& path)
+	{
+		std::string data{};
+		if (!utilities::io::read_file(path, &data)) return;
+
+		const auto intact = record_log::replay(data, [&](const std::string_view record)
+		{
+			deserialize_entries(record, [&](const entry& entry)
+			{
+				this->values_[entry.key] = entry.value;
+			});
+		});
+
+		if (intact != data.size())
+		{
+			logger::write(logger::LOG_TYPE_DEBUG, "[DW]: [key_store]: dropping %zu damaged bytes from '%s'\n", data.size() - intact, path.data());
+		}
+
+		if (path == this->log_path_) this->log_size_ = data.size();
+	}
+
+	void key_store::compact()
+	{
+		std::vector<entry> entries{};
+		entries.reserve(this->values_.size());
+
+		for (const auto& [key, value] : this->values_)
+		{
+			entries.push_back({ key, value });
+		}
+
+		// the log only goes once the snapshot holding everything in it is in place
+		if (!record_log::rewrite(this->snapshot_path_, serialize_entries(entries))) return;
+
+		utilities::io::remove_file(this->log_path_);
+		this->log_size_ = 0;
+	}
+
+	key_store& get_key_store()
+	{
+		static key_store instance{ std::format("players/keyarchive-{}.db", platform::bnet_get_userid()) };
+		return instance;
+	}
+}
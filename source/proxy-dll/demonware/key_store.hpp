@@ -0,0 +1,63 @@
+#pragma once
+
+namespace demonware
+{
+	// local backing for bdKeyArchive, values keyed by (entity id, category, index)
+	// live in memory and every batch of writes is appended to a write-ahead log
+	// before it is applied, the log is folded into a snapshot once it grows
+	class key_store final
+	{
+	public:
+		struct value_key
+		{
+			uint64_t entity_id;
+			uint16_t category;
+			uint16_t index;
+
+			auto operator<=>(const value_key&) const = default;
+		};
+
+		struct entry
+		{
+			value_key key;
+			int64_t value;
+		};
+
+		enum write_type : uint32_t
+		{
+			WRITE_REPLACE = 0,
+			WRITE_ADD = 1,
+			WRITE_MAX = 2,
+			WRITE_MIN = 3,
+		};
+
+		struct update
+		{
+			entry target;
+			write_type type = WRITE_REPLACE;
+		};
+
+		explicit key_store(std::string path);
+
+		std::optional<int64_t> read(const value_key& key) const;
+		std::vector<entry> read_all(uint64_t entity_id, uint16_t category) const;
+
+		// applied and logged as one record
+		bool write(const std::vector<update>& updates);
+
+	private:
+		static constexpr size_t compact_threshold = 0x400000;
+
+		std::string snapshot_path_;
+		std::string log_path_;
+		size_t log_size_ = 0;
+
+		mutable std::mutex mutex_{};
+		std::map<value_key, int64_t> values_{};
+
+		void load(const std::string& path);
+		void compact();
+	};
+
+	key_store& get_key_store();
+}
@@ -14,65 +14,295 @@
 
 namespace demonware
 {
-	std::string HexStringToBinaryString(const std::string& hex_str)
+#ifndef PUBLISHER_OBJECTS_ENUMERATE_LPC_DIR
+	namespace
 	{
-		std::string data{};
+		int hex_nibble(const char c)
+		{
+			if (c >= '0' && c <= '9') return c - '0';
+			if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+			if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+			return -1;
+		}
+
+		std::string hex_to_binary(const std::string_view hex)
+		{
+			std::string data(hex.size() / 2, '\0');
+
+			for (size_t i = 0; i < data.size(); i++)
+			{
+				const auto high = hex_nibble(hex[i * 2]);
+				const auto low = hex_nibble(hex[i * 2 + 1]);
+				if (high < 0 || low < 0) return {};
+
+				data[i] = static_cast<char>((high << 4) | low);
+			}
 
-		for (unsigned int i = 0; i < hex_str.length(); i += 2) {
-			std::string byteString = hex_str.substr(i, 2);
-			char byte = (char)strtol(byteString.c_str(), NULL, 16);
-			data.push_back(byte);
+			return data;
 		}
 
-		return data;
+		std::string_view next_token(std::string_view* input, const char delimiter)
+		{
+			const auto end = input->find(delimiter);
+			const auto token = input->substr(0, end);
+
+			input->remove_prefix(end == std::string_view::npos ? input->size() : end + 1);
+			return token;
+		}
+
+		// "name,length,md5 hex" rows, parsed in one pass without splitting into temporaries
+		std::vector<objectMetadata> parse_publisher_objects_csv(std::string_view csv, const int64_t timestamp)
+		{
+			std::vector<objectMetadata> result{};
+			result.reserve(std::count(csv.begin(), csv.end(), '\n') + 1);
+
+			while (!csv.empty())
+			{
+				auto row = next_token(&csv, '\n');
+				if (!row.empty() && row.back() == '\r') row.remove_suffix(1);
+				if (row.empty()) continue;
+
+				const auto name = next_token(&row, ',');
+				const auto length = next_token(&row, ',');
+				const auto checksum = next_token(&row, ',');
+
+				uint64_t content_length = 0;
+				std::from_chars(length.data(), length.data() + length.size(), content_length);
+
+				result.push_back({ "treyarch", std::string(name), utilities::cryptography::base64::encode(hex_to_binary(checksum)), content_length, timestamp, timestamp, "" });
+			}
+
+			return result;
+		}
 	}
+#endif // PUBLISHER_OBJECTS_ENUMERATE_LPC_DIR
 
-	std::string get_publisher_file_checksum(std::string file)
+	namespace
 	{
-		std::string file_data;
-		if (!utilities::io::read_file(file, &file_data)) return "";
+		struct indexed_file
+		{
+			std::string name;
+			uint64_t size;
+			int64_t mtime;
+			std::string checksum;
+		};
+
+		// remembers (name, size, mtime, checksum) per directory and only hashes files whose
+		// size or mtime changed since they were last seen; the index is kept on disk so a
+		// restart doesn't rehash everything either
+		class object_index
+		{
+		public:
+			using checksum_function = std::string(*)(const std::string& data);
+
+			object_index(const char* name, const checksum_function checksum)
+				: name_(name), checksum_(checksum)
+			{
+			}
+
+			std::vector<indexed_file> list(const std::string& directory, const std::string_view extension = {})
+			{
+				std::vector<indexed_file> result{};
+
+				std::lock_guard<std::mutex> _(this->mutex_);
+				auto& entries = this->load(directory);
+
+				std::unordered_set<std::string> seen{};
+				auto dirty = false;
+
+				std::error_code ec{};
+				for (const auto& entry : std::filesystem::directory_iterator(directory, ec))
+				{
+					// directory entries carry size and mtime from the enumeration itself
+					if (entry.is_directory(ec)) continue;
+
+					auto name = entry.path().filename().string();
+					if (!extension.empty() && !name.ends_with(extension)) continue;
+
+					const auto size = entry.file_size(ec);
+					const auto mtime = entry.last_write_time(ec).time_since_epoch().count();
+
+					seen.insert(name);
+					result.push_back(this->refresh(entries, directory, std::move(name), size, mtime, &dirty));
+				}
+
+				if (extension.empty())
+				{
+					dirty |= std::erase_if(entries, [&](const auto& entry)
+					{
+						return !seen.contains(entry.first);
+					}) != 0;
+				}
+
+				if (dirty) this->save(directory, entries);
+
+				return result;
+			}
+
+			indexed_file get(const std::string& directory, const std::string& name)
+			{
+				const auto path = std::format("{}/{}", directory, name);
+
+				std::error_code ec{};
+				const auto size = std::filesystem::file_size(path, ec);
+				if (ec) return { name, 0, 0, "" };
+
+				const auto mtime = std::filesystem::last_write_time(path, ec).time_since_epoch().count();
+
+				std::lock_guard<std::mutex> _(this->mutex_);
+				auto& entries = this->load(directory);
+
+				auto dirty = false;
+				auto file = this->refresh(entries, directory, name, size, mtime, &dirty);
+
+				if (dirty) this->save(directory, entries);
+
+				return file;
+			}
+
+		private:
+			using directory_entries = std::unordered_map<std::string, indexed_file>;
+
+			const char* name_;
+			checksum_function checksum_;
+
+			std::mutex mutex_{};
+			std::unordered_map<std::string, directory_entries> directories_{};
+
+			indexed_file refresh(directory_entries& entries, const std::string& directory, std::string name
+				, const uint64_t size, const int64_t mtime, bool* dirty) const
+			{
+				const auto entry = entries.find(name);
+				if (entry != entries.end() && entry->second.size == size && entry->second.mtime == mtime)
+				{
+					return entry->second;
+				}
+
+				std::string file_data{};
+				if (!utilities::io::read_file(std::format("{}/{}", directory, name), &file_data))
+				{
+					return { std::move(name), size, mtime, "" };
+				}
+
+				indexed_file file{ name, size, mtime, this->checksum_(file_data) };
+				entries[std::move(name)] = file;
+				*dirty = true;
+
+				return file;
+			}
+
+			std::string get_index_path(const std::string& directory) const
+			{
+				auto file = directory;
+				std::replace_if(file.begin(), file.end(), [](const char c) { return c == '/' || c == '\\' || c == ':'; }, '_');
+
+				return std::format("project-bo4/cache/{}/{}.index", this->name_, file);
+			}
+
+			directory_entries& load(const std::string& directory)
+			{
+				const auto existing = this->directories_.find(directory);
+				if (existing != this->directories_.end()) return existing->second;
+
+				auto& entries = this->directories_[directory];
 
-		std::string checksum_md5 = utilities::cryptography::md5::compute(file_data);
+				std::string data{};
+				if (!utilities::io::read_file(this->get_index_path(directory), &data)) return entries;
 
-		return utilities::cryptography::base64::encode(checksum_md5);
+				// one "name\tsize\tmtime\tchecksum" line per file
+				for (const auto& line : utilities::string::split(data, '\n'))
+				{
+					const auto fields = utilities::string::split(line, '\t');
+					if (fields.size() != 4) continue;
+
+					indexed_file file{ fields[0], 0, 0, fields[3] };
+					std::from_chars(fields[1].data(), fields[1].data() + fields[1].size(), file.size);
+					std::from_chars(fields[2].data(), fields[2].data() + fields[2].size(), file.mtime);
+
+					entries[file.name] = std::move(file);
+				}
+
+				return entries;
+			}
+
+			void save(const std::string& directory, const directory_entries& entries) const
+			{
+				std::string data{};
+				data.reserve(entries.size() * 64);
+
+				for (const auto& [name, file] : entries)
+				{
+					if (name.find_first_of("\t\n") != std::string::npos) continue;
+					data.append(std::format("{}\t{}\t{}\t{}\n", name, file.size, file.mtime, file.checksum));
+				}
+
+				utilities::io::write_file(this->get_index_path(directory), data);
+			}
+		};
+
+		std::string compute_publisher_checksum(const std::string& data)
+		{
+			return utilities::cryptography::base64::encode(utilities::cryptography::md5::compute(data));
+		}
+
+		std::string compute_user_checksum(const std::string& data)
+		{
+			return std::to_string(utilities::cryptography::xxh32::compute(data));
+		}
+
+		object_index publisher_index{ "publisher", compute_publisher_checksum };
+		object_index user_index{ "user", compute_user_checksum };
 	}
 
-	std::vector<objectMetadata> get_publisher_objects_list(const std::string& category)
+	// version changes whenever the listing would
+	std::vector<objectMetadata> get_publisher_objects_list(const std::string& category, uint64_t* version)
 	{
 		std::vector<objectMetadata> result;
 
 #ifdef PUBLISHER_OBJECTS_ENUMERATE_LPC_DIR
-		std::vector<std::string> files = utilities::io::list_files("LPC");
+		std::vector<indexed_file> files = publisher_index.list("LPC", ".ff");
 
-		for (std::string file : files)
+		std::string signature{};
+		for (indexed_file& file : files)
 		{
-			if (!utilities::string::ends_with(file, ".ff")) continue;
+			signature.append(std::format("{}:{}:{};", file.name, file.size, file.mtime));
 
-			int64_t timestamp = static_cast<int64_t>(time(nullptr));
-			result.push_back({ "treyarch", utilities::io::file_name(file), get_publisher_file_checksum(file), utilities::io::file_size(file), timestamp, timestamp, "" });
+			// the file time instead of the listing time, the cached listing stays the same as a fresh one
+			const std::filesystem::file_time_type file_time{ std::filesystem::file_time_type::duration{ file.mtime } };
+			const auto timestamp = static_cast<int64_t>(std::chrono::duration_cast<std::chrono::seconds>(
+				std::chrono::clock_cast<std::chrono::system_clock>(file_time).time_since_epoch()).count());
+
+			result.push_back({ "treyarch", std::move(file.name), std::move(file.checksum), file.size, timestamp, timestamp, "" });
 		}
-#else // PUBLISHER_OBJECTS_ENUMERATE_CSV_LIST
-		const auto objects_list_csv = utilities::nt::load_resource(DW_PUBLISHER_OBJECTS_LIST);
-		std::vector<std::string> items = utilities::string::split(objects_list_csv, "\r\n"); // WTF!?
 
-		for (std::string item : items)
-		{
-			std::string checksum = utilities::cryptography::base64::encode(HexStringToBinaryString(utilities::string::split(item, ',')[2]));
-			std::string name = utilities::string::split(item, ',')[0];
-			uint64_t length = std::stoull(utilities::string::split(item, ',')[1]);
+		*version = utilities::cryptography::xxh64::compute(signature);
+#else // PUBLISHER_OBJECTS_ENUMERATE_CSV_LIST
+		// the list is an embedded resource, it can't change while we're running
+		static const auto objects = parse_publisher_objects_csv(utilities::nt::load_resource(DW_PUBLISHER_OBJECTS_LIST), static_cast<int64_t>(time(nullptr)));
 
-			int64_t timestamp = static_cast<int64_t>(time(nullptr));
-			result.push_back({ "treyarch", name, checksum, length, timestamp, timestamp, "" });
-		}
+		result = objects;
+		*version = 0;
 #endif // PUBLISHER_OBJECTS_ENUMERATE_LPC_DIR
 
 		return result;
 	}
 
-	std::string generate_publisher_objects_list_json(const std::string& category)
+	void generate_publisher_objects_list_json(objectstore_payload* payload, const std::string& category)
 	{
-		rapidjson::StringBuffer json_buffer{};
-		rapidjson::PrettyWriter<rapidjson::StringBuffer> json_writer(json_buffer);
+		static std::mutex cache_mutex{};
+		static std::optional<uint64_t> cached_version{};
+		static std::string cached_json{};
+
+		uint64_t version = 0;
+		std::vector<objectMetadata> objects = get_publisher_objects_list(category, &version);
+
+		std::lock_guard<std::mutex> _(cache_mutex);
+		if (cached_version == version)
+		{
+			return payload->append(cached_json);
+		}
+
+		objectstore_writer json_writer(*payload);
 
 		json_writer.StartObject();
 
@@ -85,9 +315,7 @@ namespace demonware
 		json_writer.Key("objects");
 		json_writer.StartArray();
 
-		std::vector<objectMetadata> objects = get_publisher_objects_list(category);
-
-		for (objectMetadata object : objects)
+		for (const objectMetadata& object : objects)
 		{
 			json_writer.StartObject();
 
@@ -148,7 +376,8 @@ namespace demonware
 
 		json_writer.EndObject();
 
-		return json_buffer.GetString();
+		cached_version = version;
+		cached_json.assign(payload->json());
 	}
 
 	std::string get_user_file_path(const std::string& file)
@@ -156,14 +385,6 @@ namespace demonware
 		return std::format("{}/{}", platform::get_userdata_directory(), file);
 	}
 
-	std::string get_user_file_checksum(std::string file_path)
-	{
-		std::string file_data;
-		if (!utilities::io::read_file(file_path, &file_data)) return "";
-
-		return std::to_string(utilities::cryptography::xxh32::compute(file_data));
-	}
-
 	std::string get_user_file_content(std::string file_path)
 	{
 		std::string file_data;
@@ -172,10 +393,9 @@ namespace demonware
 		return utilities::cryptography::base64::encode(file_data);
 	}
 
-	std::string deliver_user_objects_vectorized_json(std::vector<objectMetadata> requested_items)
+	void deliver_user_objects_vectorized_json(objectstore_payload* payload, const std::vector<objectMetadata>& requested_items)
 	{
-		rapidjson::StringBuffer json_buffer{};
-		rapidjson::PrettyWriter<rapidjson::StringBuffer> json_writer(json_buffer);
+		objectstore_writer json_writer(*payload);
 
 		json_writer.StartObject();
 
@@ -282,28 +502,26 @@ namespace demonware
 		json_writer.EndArray();
 
 		json_writer.EndObject();
-
-		return json_buffer.GetString();
 	}
 
-	std::string deliver_user_objects_vectorized_json(std::vector<objectID> requested_items)
+	void deliver_user_objects_vectorized_json(objectstore_payload* payload, const std::vector<objectID>& requested_items)
 	{
 		std::vector<objectMetadata> files_metadata_list;
 
-		for (objectID file : requested_items)
+		for (const objectID& file : requested_items)
 		{
 			std::string file_path = get_user_file_path(file.name);
+			indexed_file indexed = user_index.get(platform::get_userdata_directory(), file.name);
 			int64_t timestamp = static_cast<int64_t>(time(nullptr));
-			files_metadata_list.push_back({ file.owner, file.name, get_user_file_checksum(file_path), utilities::io::file_size(file_path), timestamp, timestamp, get_user_file_content(file_path) });
+			files_metadata_list.push_back({ file.owner, file.name, std::move(indexed.checksum), indexed.size, timestamp, timestamp, indexed.size ? get_user_file_content(file_path) : "" });
 		}
 
-		return deliver_user_objects_vectorized_json(files_metadata_list);
+		deliver_user_objects_vectorized_json(payload, files_metadata_list);
 	}
 
-	std::string generate_user_objects_list_json()
+	void generate_user_objects_list_json(objectstore_payload* payload)
 	{
-		rapidjson::StringBuffer json_buffer{};
-		rapidjson::PrettyWriter<rapidjson::StringBuffer> json_writer(json_buffer);
+		objectstore_writer json_writer(*payload);
 
 		json_writer.StartObject();
 
@@ -320,9 +538,9 @@ namespace demonware
 
 		if (utilities::io::directory_exists(userdata_directory))
 		{
-			std::vector<std::string> user_objects = utilities::io::list_files(userdata_directory);
+			std::vector<indexed_file> user_objects = user_index.list(userdata_directory);
 
-			for (std::string object : user_objects)
+			for (const indexed_file& object : user_objects)
 			{
 				json_writer.StartObject();
 
@@ -336,10 +554,10 @@ namespace demonware
 				json_writer.Uint(0);
 
 				json_writer.Key("name");
-				json_writer.String(utilities::io::file_name(object));
+				json_writer.String(object.name);
 
 				json_writer.Key("checksum");
-				json_writer.String(get_user_file_checksum(object));
+				json_writer.String(object.checksum);
 
 				json_writer.Key("acl");
 				json_writer.String("public");
@@ -354,7 +572,7 @@ namespace demonware
 				json_writer.Null();
 
 				json_writer.Key("contentLength");
-				json_writer.Uint64(utilities::io::file_size(object));
+				json_writer.Uint64(object.size);
 
 				json_writer.Key("context");
 				json_writer.String("t8-bnet");
@@ -395,11 +613,9 @@ namespace demonware
 		json_writer.EndArray();
 
 		json_writer.EndObject();
-
-		return json_buffer.GetString();
 	}
 
-	std::string generate_user_objects_count_json()
+	void generate_user_objects_count_json(objectstore_payload* payload)
 	{
 		std::string userdata_directory = platform::get_userdata_directory();
 
@@ -410,8 +626,7 @@ namespace demonware
 		}
 
 
-		rapidjson::StringBuffer json_buffer{};
-		rapidjson::PrettyWriter<rapidjson::StringBuffer> json_writer(json_buffer);
+		objectstore_writer json_writer(*payload);
 
 		json_writer.StartObject();
 
@@ -426,16 +641,13 @@ namespace demonware
 		json_writer.EndObject();
 
 		json_writer.EndObject();
-
-		return json_buffer.GetString();
 	}
 
-	std::string construct_file_upload_result_json(const std::string& uploaded_file)
+	void construct_file_upload_result_json(objectstore_payload* payload, const std::string& uploaded_file)
 	{
-		std::string file_path = get_user_file_path(uploaded_file);
+		indexed_file indexed = user_index.get(platform::get_userdata_directory(), uploaded_file);
 
-		rapidjson::StringBuffer json_buffer{};
-		rapidjson::PrettyWriter<rapidjson::StringBuffer> json_writer(json_buffer);
+		objectstore_writer json_writer(*payload);
 
 		json_writer.StartObject();
 
@@ -452,7 +664,7 @@ namespace demonware
 		json_writer.String(uploaded_file);
 
 		json_writer.Key("checksum");
-		json_writer.String(get_user_file_checksum(file_path));
+		json_writer.String(indexed.checksum);
 
 		json_writer.Key("acl");
 		json_writer.String("public");
@@ -467,7 +679,7 @@ namespace demonware
 		json_writer.Null();
 
 		json_writer.Key("contentLength");
-		json_writer.Uint64(utilities::io::file_size(file_path));
+		json_writer.Uint64(indexed.size);
 
 		json_writer.Key("context");
 		json_writer.String("t8-bnet");
@@ -495,14 +707,11 @@ namespace demonware
 		json_writer.EndObject();
 
 		json_writer.EndObject();
-
-		return json_buffer.GetString();
 	}
 
-	std::string construct_vectorized_upload_list_json(std::vector<objectMetadata> uploaded_files)
+	void construct_vectorized_upload_list_json(objectstore_payload* payload, const std::vector<objectMetadata>& uploaded_files)
 	{
-		rapidjson::StringBuffer json_buffer{};
-		rapidjson::PrettyWriter<rapidjson::StringBuffer> json_writer(json_buffer);
+		objectstore_writer json_writer(*payload);
 
 		json_writer.StartObject();
 
@@ -587,41 +796,88 @@ namespace demonware
 		json_writer.EndArray();
 
 		json_writer.EndObject();
-
-		return json_buffer.GetString();
 	}
 
-	std::string construct_vectorized_upload_list_json(std::vector<std::string> uploaded_files)
+	void construct_vectorized_upload_list_json(objectstore_payload* payload, const std::vector<std::string>& uploaded_files)
 	{
 		std::vector<objectMetadata> files_metadata_list;
 
-		for (std::string file : uploaded_files)
+		for (const std::string& file : uploaded_files)
 		{
 			std::string file_path = get_user_file_path(file);
+			indexed_file indexed = user_index.get(platform::get_userdata_directory(), file);
 			int64_t timestamp = static_cast<int64_t>(time(nullptr));
-			files_metadata_list.push_back({ std::format("bnet-{}", platform::bnet_get_userid()), file, get_user_file_checksum(file_path), utilities::io::file_size(file_path), timestamp, timestamp, get_user_file_content(file_path) });
+			files_metadata_list.push_back({ std::format("bnet-{}", platform::bnet_get_userid()), file, std::move(indexed.checksum), indexed.size, timestamp, timestamp, get_user_file_content(file_path) });
 		}
 
-		return construct_vectorized_upload_list_json(files_metadata_list);
+		construct_vectorized_upload_list_json(payload, files_metadata_list);
 	}
 
-	std::string serialize_objectstore_structed_buffer(std::string payload)
+	namespace
 	{
-		bdProtobufHelper header_1st;
-		header_1st.writeString(1, "Content-Length", 16);
-		header_1st.writeString(2, utilities::string::va("%u", payload.length()), 8);
+		void write_varint(std::string& buffer, uint64_t value)
+		{
+			while (value >= 0x80)
+			{
+				buffer.push_back(static_cast<char>(value | 0x80));
+				value >>= 7;
+			}
+
+			buffer.push_back(static_cast<char>(value));
+		}
+
+		void write_field(std::string& buffer, const uint32_t tag, const std::string_view value)
+		{
+			write_varint(buffer, (tag << 3) | WIRETYPE_STRING);
+			write_varint(buffer, value.size());
+			buffer.append(value);
+		}
+	}
+
+	objectstore_payload::objectstore_payload()
+	{
+		this->buffer_.reserve(0x1000);
+		this->buffer_.resize(wrapper_reserve);
+	}
+
+	void objectstore_payload::append(const std::string_view json)
+	{
+		this->buffer_.append(json);
+	}
+
+	std::string_view objectstore_payload::json() const
+	{
+		return std::string_view(this->buffer_).substr(wrapper_reserve);
+	}
+
+	std::string objectstore_payload::finalize()
+	{
+		const auto length = this->buffer_.size() - wrapper_reserve;
+
+		std::string content_length{};
+		write_field(content_length, 1, "Content-Length");
+		write_field(content_length, 2, std::to_string(length));
+
+		std::string authorization{};
+		write_field(authorization, 1, "Authorization");
+		write_field(authorization, 2, "Bearer project-bo4");
 
-		bdProtobufHelper header_2nd;
-		header_2nd.writeString(1, "Authorization", 16);
-		header_2nd.writeString(2, "Bearer project-bo4", 2048);
+		std::string wrapper{};
+		write_field(wrapper, 1, content_length);
+		write_field(wrapper, 1, authorization);
+		write_varint(wrapper, (2 << 3) | WIRETYPE_VARINT);
+		write_varint(wrapper, 200); // Status Code; Anything NON-2XX is Treated as Error
+		write_varint(wrapper, (3 << 3) | WIRETYPE_STRING);
+		write_varint(wrapper, length);
 
+		// the wrapper ends right where the json starts, only the unused part of the reserve is dropped
+		const auto offset = wrapper_reserve - wrapper.size();
+		std::memcpy(this->buffer_.data() + offset, wrapper.data(), wrapper.size());
+		this->buffer_.erase(0, offset);
 
-		bdProtobufHelper buffer;
-		buffer.writeString(1, header_1st.buffer.data(), static_cast<uint32_t>(header_1st.buffer.length()));
-		buffer.writeString(1, header_2nd.buffer.data(), static_cast<uint32_t>(header_2nd.buffer.length()));
-		buffer.writeUInt64(2, 200); // Status Code; Anything NON-2XX is Treated as Error
-		buffer.writeString(3, payload.data(), static_cast<uint32_t>(payload.length()));
+		auto message = std::move(this->buffer_);
+		this->buffer_.clear();
 
-		return buffer.buffer;
+		return message;
 	}
 }
@@ -19,20 +19,44 @@ namespace demonware
 		std::string contentURL;
 	};
 
-	std::string get_user_file_path(const std::string& file);
+	// objectstore replies are json wrapped in a small protobuf message, the json is written
+	// compactly behind room left for the wrapper, which is filled in once its length is known
+	class objectstore_payload final
+	{
+	public:
+		using Ch = char;
+
+		objectstore_payload();
+
+		void Put(const char c) { this->buffer_.push_back(c); }
+		void Flush() {}
+
+		void append(std::string_view json);
+		std::string_view json() const;
+
+		// wraps the json and hands the finished message over, the payload is empty afterwards
+		std::string finalize();
 
-	std::string generate_publisher_objects_list_json(const std::string& category);
+	private:
+		static constexpr size_t wrapper_reserve = 96;
+
+		std::string buffer_{};
+	};
+
+	using objectstore_writer = rapidjson::Writer<objectstore_payload>;
+
+	std::string get_user_file_path(const std::string& file);
 
-	std::string construct_file_upload_result_json(const std::string& uploaded_file);
+	void generate_publisher_objects_list_json(objectstore_payload* payload, const std::string& category);
 
-	std::string generate_user_objects_list_json();
-	std::string generate_user_objects_count_json();
+	void construct_file_upload_result_json(objectstore_payload* payload, const std::string& uploaded_file);
 
-	std::string deliver_user_objects_vectorized_json(std::vector<objectMetadata> requested_items);
-	std::string deliver_user_objects_vectorized_json(std::vector<objectID> requested_items);
+	void generate_user_objects_list_json(objectstore_payload* payload);
+	void generate_user_objects_count_json(objectstore_payload* payload);
 
-	std::string construct_vectorized_upload_list_json(std::vector<objectMetadata> uploaded_files);
-	std::string construct_vectorized_upload_list_json(std::vector<std::string> uploaded_files);
+	void deliver_user_objects_vectorized_json(objectstore_payload* payload, const std::vector<objectMetadata>& requested_items);
+	void deliver_user_objects_vectorized_json(objectstore_payload* payload, const std::vector<objectID>& requested_items);
 
-	std::string serialize_objectstore_structed_buffer(std::string payload);
+	void construct_vectorized_upload_list_json(objectstore_payload* payload, const std::vector<objectMetadata>& uploaded_files);
+	void construct_vectorized_upload_list_json(objectstore_payload* payload, const std::vector<std::string>& uploaded_files);
 }
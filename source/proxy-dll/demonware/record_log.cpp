@@ -0,0 +1,54 @@
+#include <std_include.hpp>
+#include "record_log.hpp"
+
+#include <utilities/io.hpp>
+#include <utilities/cryptography.hpp>
+
+namespace demonware::record_log
+{
+	std::string frame(const std::string_view payload)
+	{
+		const auto size = static_cast<uint32_t>(payload.size());
+		const auto hash = utilities::cryptography::xxh32::compute(reinterpret_cast<const uint8_t*>(payload.data()), payload.size());
+
+		std::string record{};
+		record.reserve(header_size + payload.size());
+		record.append(reinterpret_cast<const char*>(&size), sizeof(size));
+		record.append(reinterpret_cast<const char*>(&hash), sizeof(hash));
+		record.append(payload);
+
+		return record;
+	}
+
+	size_t replay(const std::string_view log, const std::function<void(std::string_view)>& handler)
+	{
+		size_t offset = 0;
+		while (log.size() - offset >= header_size)
+		{
+			uint32_t size{}, hash{};
+			std::memcpy(&size, log.data() + offset, sizeof(size));
+			std::memcpy(&hash, log.data() + offset + sizeof(size), sizeof(hash));
+
+			if (size > log.size() - offset - header_size) break;
+
+			const auto payload = log.substr(offset + header_size, size);
+			if (utilities::cryptography::xxh32::compute(reinterpret_cast<const uint8_t*>(payload.data()), payload.size()) != hash) break;
+
+			handler(payload);
+			offset += header_size + size;
+		}
+
+		return offset;
+	}
+
+	bool rewrite(const std::string& path, const std::string& records)
+	{
+		const auto temp_path = path + ".tmp";
+		if (!utilities::io::write_file(temp_path, records)) return false;
+
+		std::error_code ec{};
+		std::filesystem::rename(temp_path, path, ec);
+
+		return !ec;
+	}
+}
@@ -0,0 +1,16 @@
+#pragma once
+
+namespace demonware::record_log
+{
+	// size, xxh32 of the payload, payload
+	constexpr size_t header_size = 8;
+
+	std::string frame(std::string_view payload);
+
+	// hands every intact record to the handler and returns how many bytes they span,
+	// anything past that is a torn or damaged write
+	size_t replay(std::string_view log, const std::function<void(std::string_view)>& handler);
+
+	// replaces path with the given records through a temp file
+	bool rewrite(const std::string& path, const std::string& records);
+}
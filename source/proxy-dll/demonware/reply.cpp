@@ -11,58 +11,62 @@ namespace demonware
 	{
 		byte_buffer result;
 		result.set_use_data_types(false);
+		result.reserve(this->buffer_.size() + 6);
 
 		result.write_int32(static_cast<int>(this->buffer_.size()) + 2);
 		result.write_bool(false);
 		result.write_ubyte(this->type());
 		result.write(this->buffer_);
 
-		return result.get_buffer();
+		return std::move(result.get_buffer());
 	}
 
 	std::string encrypted_reply::data()
 	{
-		byte_buffer result;
-		result.set_use_data_types(false);
+		// header : encrypted service data : hash
+		constexpr size_t header_size = 26;
+		constexpr size_t hash_size = 8;
 
-		byte_buffer enc_buffer;
-		enc_buffer.set_use_data_types(false);
+		const auto service_size = this->buffer_.size() + 5;
+		const auto aligned_size = ~15 & (service_size + 15); // 16 byte align
 
-		enc_buffer.write_uint32(static_cast<unsigned int>(this->buffer_.size())); // service data size CHECKTHIS!!
-		enc_buffer.write_ubyte(this->type()); // TASK_REPLY type
-		enc_buffer.write(this->buffer_); // service data
+		// the whole packet is assembled in place, the header is filled in once the payload size is known
+		byte_buffer response;
+		response.set_use_data_types(false);
+		response.reserve(header_size + aligned_size + hash_size);
+		response.reserve_prefix(header_size);
 
-		auto aligned_data = enc_buffer.get_buffer();
-		auto size = aligned_data.size();
-		size = ~15 & (size + 15); // 16 byte align
-		aligned_data.resize(size);
+		response.write_uint32(static_cast<unsigned int>(this->buffer_.size())); // service data size CHECKTHIS!!
+		response.write_ubyte(this->type()); // TASK_REPLY type
+		response.write(this->buffer_); // service data
 
-		// seed
-		std::string seed("\x5E\xED\x5E\xED\x5E\xED\x5E\xED\x5E\xED\x5E\xED\x5E\xED\x5E\xED", 16);
+		static constexpr char padding[16]{};
+		response.write(static_cast<int>(aligned_size - service_size), padding);
 
-		// encrypt
-		const auto enc_data = utilities::cryptography::aes::encrypt(aligned_data, seed, demonware::get_encrypt_key());
+		// seed
+		const std::string seed("\x5E\xED\x5E\xED\x5E\xED\x5E\xED\x5E\xED\x5E\xED\x5E\xED\x5E\xED", 16);
 
-		// header : encrypted service data : hash
 		static auto msg_count = 0;
 		msg_count++;
 
-		byte_buffer response;
-		response.set_use_data_types(false);
+		response.write_prefix(static_cast<int>(seed.size()), seed.data());
+		response.write_prefix(msg_count);
+		response.write_prefix(static_cast<unsigned char>(0x85));
+		response.write_prefix(static_cast<unsigned char>(0xAB));
+		response.write_prefix(30 + static_cast<int>(aligned_size));
+
+		auto& packet = response.get_buffer();
 
-		response.write_int32(30 + static_cast<int>(enc_data.size()));
-		response.write_ubyte(static_cast<unsigned char>(0xAB));
-		response.write_ubyte(static_cast<unsigned char>(0x85));
-		response.write_int32(msg_count);
-		response.write(16, seed.data());
-		response.write(enc_data);
+		// encrypt
+		utilities::cryptography::aes::encrypt(reinterpret_cast<uint8_t*>(packet.data()) + header_size, aligned_size,
+			seed, demonware::get_encrypt_key());
 
 		// hash entire packet and append end
-		auto hash_data = utilities::cryptography::hmac_sha1::compute(response.get_buffer(), demonware::get_hmac_key());
-		hash_data.resize(8);
-		response.write(8, hash_data.data());
+		const auto hash_data = utilities::cryptography::hmac_sha1::compute(
+			reinterpret_cast<const uint8_t*>(packet.data()), packet.size(), demonware::get_hmac_key());
+		response.write(static_cast<int>(hash_size), hash_data.data());
 
-		return response.get_buffer();
+		return std::move(response.get_buffer());
 	}
 
 	void remote_reply::send(bit_buffer* buffer, const bool encrypted)
@@ -60,9 +60,10 @@ namespace demonware
 			this->buffer_.append(bbuffer->get_buffer());
 		}
 
+		// takes over the contents of bbuffer instead of copying them
 		encrypted_reply(const uint8_t type, byte_buffer* bbuffer) : typed_reply(type)
 		{
-			this->buffer_.append(bbuffer->get_buffer());
+			this->buffer_ = std::move(bbuffer->get_buffer());
 		}
 
 		std::string data() override;
@@ -76,9 +77,10 @@ namespace demonware
 			this->buffer_.append(bbuffer->get_buffer());
 		}
 
+		// takes over the contents of bbuffer instead of copying them
 		unencrypted_reply(const uint8_t _type, byte_buffer* bbuffer) : typed_reply(_type)
 		{
-			this->buffer_.append(bbuffer->get_buffer());
+			this->buffer_ = std::move(bbuffer->get_buffer());
 		}
 
 		std::string data() override;
@@ -117,6 +119,7 @@ namespace demonware
 			const auto transaction_id = ++id;
 
 			byte_buffer buffer;
+			buffer.reserve(this->serialized_size());
 			buffer.write_uint64(transaction_id);
 			buffer.write_uint32(this->error_);
 			buffer.write_ubyte(this->type_);
@@ -172,6 +175,23 @@ namespace demonware
 		bool structed_;
 		remote_reply reply_;
 		std::vector<std::shared_ptr<bdTaskResult>> objects_;
+
+		size_t serialized_size() const
+		{
+			// transaction id, error and type, each with its data type tag
+			size_t size = 9 + 5 + 2;
+
+			if (this->error_) return size + 9;
+			if (!this->structed_) size += 5 + (this->objects_.empty() ? 0 : 5);
+
+			for (const auto& object : this->objects_)
+			{
+				size += object->serialized_size(true);
+				if (this->structed_) break;
+			}
+
+			return size;
+		}
 	};
 	
 	class structure_reply final
@@ -182,10 +202,10 @@ namespace demonware
 		{
 		}
 
-		uint64_t send(const std::string& buffer)
+		uint64_t send(std::string buffer)
 		{
 			auto result = new bdStructedDataBuffer;
-			result->structed_data_protobuffer = buffer;
+			result->structed_data_protobuffer = std::move(buffer);
 
 			this->reply_.add(result);
 
@@ -0,0 +1,213 @@
+#pragma once
+
+#include "byte_buffer.hpp"
+
+namespace demonware::serializer
+{
+	namespace data_type
+	{
+		constexpr char boolean = 1;
+		constexpr char int16 = 5;
+		constexpr char uint16 = 6;
+		constexpr char int32 = 7;
+		constexpr char uint32 = 8;
+		constexpr char int64 = 9;
+		constexpr char uint64 = 10;
+		constexpr char float32 = 13;
+		constexpr char string = 16;
+		constexpr char blob = 0x13;
+		constexpr char structure = 0x17;
+		constexpr char uint64_array = uint64 + 100;
+	}
+
+	using tag_map = std::map<uint64_t, uint64_t>;
+
+	template <typename T>
+	constexpr char type_of()
+	{
+		if constexpr (std::is_same_v<T, bool>) return data_type::boolean;
+		else if constexpr (std::is_same_v<T, int16_t>) return data_type::int16;
+		else if constexpr (std::is_same_v<T, uint16_t>) return data_type::uint16;
+		else if constexpr (std::is_same_v<T, int32_t>) return data_type::int32;
+		else if constexpr (std::is_same_v<T, uint32_t>) return data_type::uint32;
+		else if constexpr (std::is_same_v<T, int64_t>) return data_type::int64;
+		else if constexpr (std::is_same_v<T, uint64_t>) return data_type::uint64;
+		else if constexpr (std::is_same_v<T, float>) return data_type::float32;
+		else static_assert(!sizeof(T), "unsupported field type");
+	}
+
+	template <char Type, typename Class, typename Value>
+	struct field
+	{
+		static constexpr auto type = Type;
+		Value Class::* member;
+	};
+
+	template <typename Class, typename Value>
+	constexpr auto value(Value Class::* member)
+	{
+		return field<type_of<Value>(), Class, Value>{member};
+	}
+
+	template <typename Class>
+	constexpr auto string(std::string Class::* member)
+	{
+		return field<data_type::string, Class, std::string>{member};
+	}
+
+	template <typename Class>
+	constexpr auto blob(std::string Class::* member)
+	{
+		return field<data_type::blob, Class, std::string>{member};
+	}
+
+	template <typename Class>
+	constexpr auto structure(std::string Class::* member)
+	{
+		return field<data_type::structure, Class, std::string>{member};
+	}
+
+	template <typename Class>
+	constexpr auto tags(tag_map Class::* member)
+	{
+		return field<data_type::uint64_array, Class, tag_map>{member};
+	}
+
+	template <typename... Fields>
+	constexpr auto fields(const Fields... list)
+	{
+		return std::make_tuple(list...);
+	}
+
+	namespace detail
+	{
+		template <typename T>
+		char* put(char* out, const T& value)
+		{
+			std::memcpy(out, &value, sizeof(T));
+			return out + sizeof(T);
+		}
+
+		inline char* put(char* out, const std::string& value, const size_t length)
+		{
+			std::memcpy(out, value.data(), length);
+			return out + length;
+		}
+
+		template <typename Object, char Type, typename Class, typename Value>
+		size_t field_size(const Object& object, const field<Type, Class, Value> f, const bool typed)
+		{
+			const auto& value = object.*f.member;
+			const size_t tag = typed ? 1 : 0;
+
+			if constexpr (Type == data_type::string)
+			{
+				return tag + value.size() + 1;
+			}
+			else if constexpr (Type == data_type::blob || Type == data_type::structure)
+			{
+				return tag + (tag + sizeof(uint32_t)) + value.size();
+			}
+			else if constexpr (Type == data_type::uint64_array)
+			{
+				// array headers carry their tags regardless of the buffer mode
+				return 1 + (1 + sizeof(uint32_t)) + sizeof(uint32_t) + value.size() * 2 * sizeof(uint64_t);
+			}
+			else
+			{
+				return tag + sizeof(Value);
+			}
+		}
+
+		template <typename Object, char Type, typename Class, typename Value>
+		char* write_field(char* out, const Object& object, const field<Type, Class, Value> f, const bool typed)
+		{
+			const auto& value = object.*f.member;
+			if (typed && Type != data_type::uint64_array) *out++ = Type;
+
+			if constexpr (Type == data_type::string)
+			{
+				out = put(out, value, value.size());
+				*out++ = '\0';
+			}
+			else if constexpr (Type == data_type::blob || Type == data_type::structure)
+			{
+				if (typed) *out++ = data_type::uint32;
+				out = put(out, static_cast<uint32_t>(value.size()));
+				out = put(out, value, value.size());
+			}
+			else if constexpr (Type == data_type::uint64_array)
+			{
+				const auto count = static_cast<uint32_t>(value.size() * 2);
+
+				*out++ = Type;
+				*out++ = data_type::uint32;
+				out = put(out, static_cast<uint32_t>(count * sizeof(uint64_t)));
+				out = put(out, count);
+
+				for (const auto& [key, val] : value)
+				{
+					out = put(out, key);
+					out = put(out, val);
+				}
+			}
+			else
+			{
+				out = put(out, value);
+			}
+
+			return out;
+		}
+
+		template <typename Object, char Type, typename Class, typename Value>
+		bool read_field(byte_buffer* buffer, Object& object, const field<Type, Class, Value> f)
+		{
+			auto& value = object.*f.member;
+
+			if constexpr (Type == data_type::string) return buffer->read_string(&value);
+			else if constexpr (Type == data_type::blob) return buffer->read_blob(&value);
+			else if constexpr (Type == data_type::structure) return buffer->read_struct(&value);
+			else if constexpr (Type == data_type::uint64_array) return buffer->read_array(data_type::uint64, &value);
+			else
+			{
+				if (!buffer->read_data_type(Type)) return false;
+				return buffer->read(sizeof(Value), &value);
+			}
+		}
+	}
+
+	// exact number of bytes write() will emit for object
+	template <typename T>
+	size_t size(const T& object, const bool typed)
+	{
+		constexpr auto layout = T::fields();
+		return std::apply([&](const auto... f)
+		{
+			return (size_t(0) + ... + detail::field_size(object, f, typed));
+		}, layout);
+	}
+
+	// emits every field of object in one pass, the buffer is only grown once
+	template <typename T>
+	void write(const T& object, byte_buffer* buffer)
+	{
+		constexpr auto layout = T::fields();
+		const auto typed = buffer->is_using_data_types();
+
+		auto* out = buffer->append(size(object, typed));
+		std::apply([&](const auto... f)
+		{
+			((out = detail::write_field(out, object, f, typed)), ...);
+		}, layout);
+	}
+
+	template <typename T>
+	bool read(T& object, byte_buffer* buffer)
+	{
+		constexpr auto layout = T::fields();
+		return std::apply([&](const auto... f)
+		{
+			return (detail::read_field(buffer, object, f) && ...);
+		}, layout);
+	}
+}
@@ -2,10 +2,35 @@
 
 namespace demonware
 {
+	// output produced on demand while the client drains it
+	class output_stream
+	{
+	public:
+		virtual ~output_stream() = default;
+
+		// copies up to size bytes into buf, returns how many were copied
+		virtual size_t read(char* buf, size_t size) = 0;
+		virtual size_t remaining() const = 0;
+	};
+
 	class base_server
 	{
 	public:
-		using stream_queue = std::queue<char>;
+		struct stream_queue
+		{
+			std::string data{};
+			size_t offset = 0;
+
+			// drained once data is empty, anything sent meanwhile is queued behind them
+			std::queue<std::unique_ptr<output_stream>> streams{};
+			size_t stream_bytes = 0;
+
+			size_t size() const
+			{
+				return this->data.size() - this->offset + this->stream_bytes;
+			}
+		};
+
 		using data_queue = std::queue<std::string>;
 
 		base_server(std::string name);
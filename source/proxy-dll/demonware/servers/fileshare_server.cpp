@@ -4,58 +4,417 @@
 #include "../fileshare.hpp"
 #include <utilities/string.hpp>
 #include <utilities/io.hpp>
-
-std::string fileshare_upload_file_name{};
-std::vector<byte> fileshare_upload_buffer{};
+#include <utilities/nt.hpp>
 
 namespace demonware
 {
-	void fileshare_server::handle(const std::string& packet)
+	namespace
 	{
-		static bool upload_in_progress = false;
+		// serves [begin, end) of a file straight out of a read-only view, so
+		// nothing but the slice being sent is ever copied
+		class mapped_file_stream final : public output_stream
+		{
+		public:
+			mapped_file_stream(utilities::nt::handle<INVALID_HANDLE_VALUE> file, const uint64_t begin, const uint64_t end)
+				: file_(std::move(file)), current_(begin), end_(end)
+			{
+				if (begin < end)
+				{
+					this->mapping_ = CreateFileMappingA(this->file_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+					if (this->mapping_)
+					{
+						this->view_ = static_cast<const char*>(MapViewOfFile(this->mapping_, FILE_MAP_READ, 0, 0, 0));
+					}
+				}
+
+				if (!this->view_)
+				{
+					this->current_ = this->end_;
+				}
+			}
+
+			~mapped_file_stream() override
+			{
+				if (this->view_)
+				{
+					UnmapViewOfFile(this->view_);
+				}
+			}
+
+			size_t read(char* buf, const size_t size) override
+			{
+				const auto count = std::min(size, this->remaining());
+				std::memcpy(buf, this->view_ + this->current_, count);
+				this->current_ += count;
+
+				return count;
+			}
+
+			size_t remaining() const override
+			{
+				return static_cast<size_t>(this->end_ - this->current_);
+			}
+
+			// an empty range doesn't need a view
+			bool is_valid() const
+			{
+				return this->view_ || !this->remaining();
+			}
+
+		private:
+			utilities::nt::handle<INVALID_HANDLE_VALUE> file_;
+			utilities::nt::handle<> mapping_{};
+			const char* view_ = nullptr;
+
+			uint64_t current_;
+			uint64_t end_;
+		};
 
-		if (packet.starts_with("GET"))
+		std::string_view get_header(const std::string& packet, const std::string_view name)
 		{
-			std::string file = utilities::string::split(utilities::string::split(packet, '\n')[0], ' ')[1].substr(1, std::string::npos);
+			for (size_t line = packet.find("\r\n"); line != std::string::npos && line + 2 < packet.size();)
+			{
+				const auto begin = line + 2;
+				const auto end = packet.find("\r\n", begin);
+				const auto header = std::string_view(packet).substr(begin, end == std::string::npos ? std::string::npos : end - begin);
+
+				if (header.size() > name.size() && header[name.size()] == ':'
+					&& !_strnicmp(header.data(), name.data(), name.size()))
+				{
+					auto value = header.substr(name.size() + 1);
+					while (!value.empty() && value.front() == ' ') value.remove_prefix(1);
+					return value;
+				}
+
+				line = end;
+			}
 
-			this->send(download_file(file));
+			return {};
 		}
-		else if (packet.starts_with("PUT"))
+
+		// only single ranges, "bytes=a-b", "bytes=a-" and "bytes=-n"
+		bool parse_range(std::string_view value, const uint64_t total, uint64_t* begin, uint64_t* end)
 		{
-			fileshare_upload_file_name = utilities::string::split(utilities::string::split(packet, '\n')[0], ' ')[1].substr(1, std::string::npos);
-			fileshare_upload_buffer.clear();
+			if (!value.starts_with("bytes=")) return false;
+			value.remove_prefix(6);
+
+			const auto dash = value.find('-');
+			if (dash == std::string_view::npos || value.find(',') != std::string_view::npos) return false;
 
-			logger::write(logger::LOG_TYPE_DEBUG, "[DW]: [fileshare]: upload stream started for '%s'\n", fileshare_upload_file_name.data());
+			const auto first = value.substr(0, dash);
+			const auto last = value.substr(dash + 1);
 
-			this->send("");
-			upload_in_progress = true;
+			uint64_t a = 0, b = 0;
+			const auto parse = [](const std::string_view str, uint64_t* out)
+			{
+				const auto [ptr, ec] = std::from_chars(str.data(), str.data() + str.size(), *out);
+				return ec == std::errc() && ptr == str.data() + str.size();
+			};
+
+			if (first.empty())
+			{
+				if (!parse(last, &b) || !b) return false;
+
+				*begin = total - std::min(b, total);
+				*end = total;
+			}
+			else
+			{
+				if (!parse(first, &a)) return false;
+				if (!last.empty() && (!parse(last, &b) || b < a)) return false;
+
+				*begin = a;
+				*end = last.empty() ? total : std::min(b + 1, total);
+			}
+
+			return *begin < *end;
 		}
-		else
+	}
+
+	chunked_upload::~chunked_upload()
+	{
+		this->abort();
+	}
+
+	bool chunked_upload::begin(const std::string& path, const std::optional<uint64_t>& content_length)
+	{
+		this->abort();
+
+		this->path_ = path;
+		this->temp_path_ = path + ".part";
+
+		// the stream buffer has to be installed before the file is opened
+		if (!this->write_buffer_) this->write_buffer_ = std::make_unique<char[]>(write_buffer_size);
+		this->stream_.rdbuf()->pubsetbuf(this->write_buffer_.get(), write_buffer_size);
+		this->stream_.open(this->temp_path_, std::ios::binary | std::ios::trunc);
+
+		if (!this->stream_.is_open())
 		{
-			if (!upload_in_progress)
+			this->state_ = state::failed;
+			return false;
+		}
+
+		this->remaining_ = content_length.value_or(0);
+		this->digits_ = 0;
+		this->line_length_ = 0;
+
+		if (!content_length) this->state_ = state::chunk_size;
+		else this->state_ = this->remaining_ ? state::identity : state::complete;
+
+		return true;
+	}
+
+	chunked_upload::status chunked_upload::feed(std::string_view data)
+	{
+		while (!data.empty())
+		{
+			const auto c = data.front();
+
+			switch (this->state_)
 			{
-				std::string http_response = "HTTP/1.1 501 Not Implemented\r\n";
-				http_response.append("Connection: close\r\n\r\n");
+			case state::chunk_size:
+				if (c == '\n')
+				{
+					if (!this->digits_) return this->fail();
+					this->state_ = this->remaining_ ? state::chunk_data : state::trailer;
+					this->digits_ = 0;
+				}
+				else if (c == ';')
+				{
+					this->state_ = state::chunk_extension;
+				}
+				else if (c != '\r')
+				{
+					uint64_t digit = 0;
+					if (c >= '0' && c <= '9') digit = c - '0';
+					else if (c >= 'a' && c <= 'f') digit = c - 'a' + 10;
+					else if (c >= 'A' && c <= 'F') digit = c - 'A' + 10;
+					else return this->fail();
 
-				return this->send(http_response);
+					if (++this->digits_ > 15) return this->fail();
+					this->remaining_ = (this->remaining_ << 4) | digit;
+				}
+
+				data.remove_prefix(1);
+				break;
+
+			case state::chunk_extension:
+				if (c == '\n')
+				{
+					if (!this->digits_) return this->fail();
+					this->state_ = this->remaining_ ? state::chunk_data : state::trailer;
+					this->digits_ = 0;
+				}
+
+				data.remove_prefix(1);
+				break;
+
+			case state::chunk_data:
+			case state::identity:
+			{
+				const auto count = static_cast<size_t>(std::min<uint64_t>(this->remaining_, data.size()));
+				if (!this->write(data.substr(0, count))) return this->fail();
+
+				data.remove_prefix(count);
+				this->remaining_ -= count;
+
+				if (!this->remaining_)
+				{
+					this->state_ = this->state_ == state::identity ? state::complete : state::chunk_data_end;
+				}
+				break;
 			}
 
-			std::string chunk_header = utilities::string::split(packet, "\r\n")[0];
-			size_t chunk_length = std::stoul(chunk_header, nullptr, 16);
+			case state::chunk_data_end:
+				if (c == '\n') this->state_ = state::chunk_size;
+				else if (c != '\r') return this->fail();
+
+				data.remove_prefix(1);
+				break;
+
+			case state::trailer:
+				if (c == '\n')
+				{
+					if (!this->line_length_) this->state_ = state::complete;
+					this->line_length_ = 0;
+				}
+				else if (c != '\r')
+				{
+					this->line_length_++;
+				}
+
+				data.remove_prefix(1);
+				break;
+
+			case state::complete:
+				// anything past the terminating chunk doesn't belong to this body
+				return status::complete;
+
+			case state::failed:
+				return status::failed;
+			}
+		}
+
+		if (this->state_ == state::complete) return status::complete;
+		if (this->state_ == state::failed) return status::failed;
+
+		return status::pending;
+	}
+
+	bool chunked_upload::commit()
+	{
+		if (this->state_ != state::complete) return false;
+
+		this->stream_.close();
+		this->state_ = state::failed;
+
+		if (this->stream_.fail())
+		{
+			this->abort();
+			return false;
+		}
+
+		std::error_code ec{};
+		std::filesystem::rename(this->temp_path_, this->path_, ec);
+		if (ec)
+		{
+			this->abort();
+			return false;
+		}
+
+		this->temp_path_.clear();
+		return true;
+	}
+
+	void chunked_upload::abort()
+	{
+		if (this->stream_.is_open())
+		{
+			this->stream_.close();
+		}
+
+		this->stream_.clear();
+		this->state_ = state::failed;
+
+		if (!this->temp_path_.empty())
+		{
+			std::error_code ec{};
+			std::filesystem::remove(this->temp_path_, ec);
+			this->temp_path_.clear();
+		}
+	}
+
+	bool chunked_upload::is_active() const
+	{
+		return this->stream_.is_open();
+	}
+
+	bool chunked_upload::write(const std::string_view data)
+	{
+		this->stream_.write(data.data(), static_cast<std::streamsize>(data.size()));
+		return this->stream_.good();
+	}
+
+	chunked_upload::status chunked_upload::fail()
+	{
+		this->state_ = state::failed;
+		return status::failed;
+	}
+
+	void fileshare_server::handle(const std::string& packet)
+	{
+		if (this->upload_.is_active())
+		{
+			return this->handle_upload(packet);
+		}
+
+		this->request_.append(packet);
+
+		const auto header_end = this->request_.find("\r\n\r\n");
+		if (header_end == std::string::npos)
+		{
+			// wait for the rest of the request header
+			if (this->request_.size() < 0x4000) return;
+			this->request_.clear();
+
+			return this->send("HTTP/1.1 400 Bad Request\r\nConnection: close\r\n\r\n");
+		}
+
+		const auto request = this->request_.substr(0, header_end + 4);
+		const auto body = this->request_.substr(header_end + 4);
+		this->request_.clear();
+
+		this->handle_request(request, body);
+	}
 
-			if (chunk_length != 0)
+	void fileshare_server::handle_request(const std::string& request, const std::string_view body)
+	{
+		const auto is_head = request.starts_with("HEAD");
+		if (is_head || request.starts_with("GET"))
+		{
+			std::string file = utilities::string::split(utilities::string::split(request, '\n')[0], ' ')[1].substr(1, std::string::npos);
+
+			this->download_file(file, get_header(request, "Range"), is_head);
+		}
+		else if (request.starts_with("PUT"))
+		{
+			this->upload_file_ = utilities::string::split(utilities::string::split(request, '\n')[0], ' ')[1].substr(1, std::string::npos);
+
+			// chunked unless a Content-Length is given, the game always sent chunked bodies
+			std::optional<uint64_t> content_length{};
+			const auto transfer_encoding = get_header(request, "Transfer-Encoding");
+			const auto length = get_header(request, "Content-Length");
+			const auto chunked = transfer_encoding.size() == 7 && !_strnicmp(transfer_encoding.data(), "chunked", 7);
+			if (!chunked && !length.empty())
 			{
-				fileshare_upload_buffer.insert(fileshare_upload_buffer.end(), &packet[chunk_header.length() + 2], &packet[chunk_header.length() + 2 + chunk_length]);
+				content_length.emplace(0);
+				const auto result = std::from_chars(length.data(), length.data() + length.size(), *content_length);
+				if (result.ec != std::errc{} || result.ptr != length.data() + length.size())
+				{
+					logger::write(logger::LOG_TYPE_DEBUG, "[DW]: [fileshare]: invalid Content-Length for upload '%s'\n", this->upload_file_.data());
+					return this->send("HTTP/1.1 400 Bad Request\r\nContent-Length: 0\r\n\r\n");
+				}
 			}
-			else
+
+			if (!this->upload_.begin(fileshare::get_file_path(this->upload_file_), content_length))
 			{
-				std::string response = finalize_upload_file(fileshare_upload_file_name, fileshare_upload_buffer);
-				upload_in_progress = false;
-				this->send(response);
+				logger::write(logger::LOG_TYPE_DEBUG, "[DW]: [fileshare]: couldnt open upload stream for '%s'\n", this->upload_file_.data());
+				return this->send("HTTP/1.1 500 Internal Server Error\r\nContent-Length: 0\r\n\r\n");
 			}
+
+			logger::write(logger::LOG_TYPE_DEBUG, "[DW]: [fileshare]: upload stream started for '%s'\n", this->upload_file_.data());
+
+			this->handle_upload(body);
+		}
+		else
+		{
+			std::string http_response = "HTTP/1.1 501 Not Implemented\r\n";
+			http_response.append("Connection: close\r\n\r\n");
+
+			this->send(http_response);
 		}
 	}
 
+	void fileshare_server::handle_upload(const std::string_view data)
+	{
+		const auto status = this->upload_.feed(data);
+		if (status == chunked_upload::status::pending)
+		{
+			return;
+		}
+
+		if (status == chunked_upload::status::complete && this->upload_.commit())
+		{
+			logger::write(logger::LOG_TYPE_DEBUG, "[DW]: [fileshare]: file upload finalized; saved as '%s'\n", this->upload_file_.data());
+			return this->send("HTTP/1.1 201 Created\r\nContent-Length: 0\r\n\r\n");
+		}
+
+		this->upload_.abort();
+
+		logger::write(logger::LOG_TYPE_DEBUG, "[DW]: [fileshare]: error on saving uploaded file '%s'\n", this->upload_file_.data());
+		this->send("HTTP/1.1 400 Bad Request\r\nContent-Length: 0\r\n\r\n");
+	}
+
 	std::string fileshare_server::http_header_time()
 	{
 		// header time
@@ -68,44 +427,80 @@ namespace demonware
 		return std::format("{} GMT", date);
 	}
 
-	std::string fileshare_server::download_file(const std::string& file)
+	void fileshare_server::download_file(const std::string& file, const std::string_view range, const bool head_only)
 	{
-		std::string http_response{}, file_buffer{};
+		std::string http_response{};
 
-		if (utilities::io::read_file(fileshare::get_file_path(file), &file_buffer))
-		{
-			logger::write(logger::LOG_TYPE_DEBUG, "[DW]: [fileshare]: hosting requested file '%s'\n", file.data());
+		utilities::nt::handle<INVALID_HANDLE_VALUE> file_handle = CreateFileA(fileshare::get_file_path(file).data(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+			OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
 
-			http_response.append("HTTP/1.1 200 OK\r\n");
-			http_response.append("Server: Apache/0.0.0 (Win64)\r\n");
-			http_response.append("Content-Type: application/octet-stream\r\n");
-			http_response.append(utilities::string::va("Date: %s\r\n", http_header_time().data()));
-			http_response.append(utilities::string::va("Content-Length: %d\r\n\r\n", file_buffer.length()));
-			http_response.append(file_buffer);
-		}
-		else
+		LARGE_INTEGER file_size{};
+		if (!file_handle || !GetFileSizeEx(file_handle, &file_size))
 		{
 			logger::write(logger::LOG_TYPE_DEBUG, "[DW]: [fileshare]: couldnt find requested file '%s'\n", file.data());
 
-			file_buffer = "<html><head><title>404 Not Found</title></head><body><h1>Not Found</h1><p>The requested URL was not found on this server.</p></body></html>";
+			const std::string body = "<html><head><title>404 Not Found</title></head><body><h1>Not Found</h1><p>The requested URL was not found on this server.</p></body></html>";
 
 			http_response.append("HTTP/1.1 404 Not Found\r\n");
 			http_response.append("Server: Apache/0.0.0 (Win64)\r\n");
 			http_response.append("Content-Type: text/html\r\n");
 			http_response.append(utilities::string::va("Date: %s\r\n", http_header_time().data()));
-			http_response.append(utilities::string::va("Content-Length: %d\r\n\r\n", file_buffer.length()));
+			http_response.append(utilities::string::va("Content-Length: %zu\r\n\r\n", body.length()));
+			if (!head_only) http_response.append(body);
+
+			return this->send(http_response);
 		}
 
-		return http_response;
-	}
+		const auto total = static_cast<uint64_t>(file_size.QuadPart);
+		uint64_t begin = 0, end = total;
 
-	std::string fileshare_server::finalize_upload_file(const std::string& file, const std::vector<byte>& buffer)
-	{
-		if(utilities::io::write_file(fileshare::get_file_path(file), std::string(buffer.begin(), buffer.end())))
-			logger::write(logger::LOG_TYPE_DEBUG, "[DW]: [fileshare]: file upload finalized; saved as '%s'\n", fileshare_upload_file_name.data());
-		else
-			logger::write(logger::LOG_TYPE_DEBUG, "[DW]: [fileshare]: error on saving uploaded file '%s'\n", fileshare_upload_file_name.data());
+		const auto partial = !range.empty();
+		if (partial && !parse_range(range, total, &begin, &end))
+		{
+			logger::write(logger::LOG_TYPE_DEBUG, "[DW]: [fileshare]: unsatisfiable range '%.*s' for file '%s'\n", static_cast<int>(range.size()), range.data(), file.data());
+
+			http_response.append("HTTP/1.1 416 Range Not Satisfiable\r\n");
+			http_response.append("Server: Apache/0.0.0 (Win64)\r\n");
+			http_response.append(utilities::string::va("Date: %s\r\n", http_header_time().data()));
+			http_response.append(utilities::string::va("Content-Range: bytes */%llu\r\n", total));
+			http_response.append("Content-Length: 0\r\n\r\n");
+
+			return this->send(http_response);
+		}
+
+		// the body is mapped before the headers, they promise its whole length
+		std::unique_ptr<mapped_file_stream> body{};
+		if (!head_only)
+		{
+			body = std::make_unique<mapped_file_stream>(std::move(file_handle), begin, end);
+			if (!body->is_valid())
+			{
+				logger::write(logger::LOG_TYPE_ERROR, "[DW]: [fileshare]: couldnt map requested file '%s'\n", file.data());
 
-		return "HTTP/1.1 201 Created\r\nContent-Length: 0\r\n\r\n";
+				http_response.append("HTTP/1.1 500 Internal Server Error\r\n");
+				http_response.append("Server: Apache/0.0.0 (Win64)\r\n");
+				http_response.append(utilities::string::va("Date: %s\r\n", http_header_time().data()));
+				http_response.append("Content-Length: 0\r\n\r\n");
+
+				return this->send(http_response);
+			}
+		}
+
+		logger::write(logger::LOG_TYPE_DEBUG, "[DW]: [fileshare]: hosting requested file '%s'\n", file.data());
+
+		http_response.append(partial ? "HTTP/1.1 206 Partial Content\r\n" : "HTTP/1.1 200 OK\r\n");
+		http_response.append("Server: Apache/0.0.0 (Win64)\r\n");
+		http_response.append("Content-Type: application/octet-stream\r\n");
+		http_response.append("Accept-Ranges: bytes\r\n");
+		http_response.append(utilities::string::va("Date: %s\r\n", http_header_time().data()));
+		if (partial) http_response.append(utilities::string::va("Content-Range: bytes %llu-%llu/%llu\r\n", begin, end - 1, total));
+		http_response.append(utilities::string::va("Content-Length: %llu\r\n\r\n", end - begin));
+
+		this->send(http_response);
+
+		if (body)
+		{
+			this->send(std::move(body));
+		}
 	}
 }
\ No newline at end of file
@@ -4,16 +4,74 @@
 
 namespace demonware
 {
+	// chunked (or content-length) request body written straight to a temp file, the
+	// parser keeps its position between feeds so a body may arrive split at any byte
+	class chunked_upload final
+	{
+	public:
+		enum class status
+		{
+			pending,
+			complete,
+			failed,
+		};
+
+		~chunked_upload();
+
+		bool begin(const std::string& path, const std::optional<uint64_t>& content_length);
+		status feed(std::string_view data);
+
+		// moves the temp file over the destination once the body is complete
+		bool commit();
+		void abort();
+
+		bool is_active() const;
+
+	private:
+		enum class state
+		{
+			chunk_size,
+			chunk_extension,
+			chunk_data,
+			chunk_data_end,
+			trailer,
+			identity,
+			complete,
+			failed,
+		};
+
+		static constexpr size_t write_buffer_size = 0x40000;
+
+		state state_ = state::failed;
+		uint64_t remaining_ = 0;
+		size_t digits_ = 0;
+		size_t line_length_ = 0;
+
+		std::string path_{};
+		std::string temp_path_{};
+		std::ofstream stream_{};
+		std::unique_ptr<char[]> write_buffer_{};
+
+		bool write(std::string_view data);
+		status fail();
+	};
+
 	class fileshare_server : public tcp_server
 	{
 	public:
 		using tcp_server::tcp_server;
 
 	private:
+		std::string request_{};
+		std::string upload_file_{};
+		chunked_upload upload_{};
+
 		void handle(const std::string& packet) override;
 
+		void handle_request(const std::string& request, std::string_view body);
+		void handle_upload(std::string_view data);
+
 		std::string http_header_time();
-		std::string download_file(const std::string& file);
-		std::string finalize_upload_file(const std::string& file, const std::vector<byte>& buffer);
+		void download_file(const std::string& file, std::string_view range, bool head_only);
 	};
 }
@@ -39,7 +39,7 @@ namespace demonware
 
 	void lobby_server::handle(const std::string& packet)
 	{
-		byte_buffer buffer(packet);
+		byte_buffer_view buffer(packet);
 		buffer.set_use_data_types(false);
 
 		try
@@ -64,8 +64,7 @@ namespace demonware
 
 					int c8;
 					buffer.read_int32(&c8);
-					std::string packet_1 = buffer.get_remaining();
-					demonware::queue_packet_to_hash(packet_1);
+					demonware::queue_packet_to_hash(std::string(buffer.get_remaining()));
 
 					/*      msgType[BYTE]    serverSelectedProto[DWORD]    cypher210ConnID[QWORD]    serverNonce[QWORD]    */
 					/*          0x81(129)                     0xD2(210)        0x3713371337133713    0x3713371337133713    */
@@ -122,16 +121,17 @@ namespace demonware
 						char seed[16];
 						buffer.read(16, &seed);
 
-						std::string enc = buffer.get_remaining();
+						const auto enc = buffer.get_remaining();
+						if (enc.size() < 8) return;
 
 						char hash[8];
 						std::memcpy(hash, &(enc.data()[enc.size() - 8]), 8);
 
-						std::string dec = utilities::cryptography::aes::decrypt(
+						const auto dec = utilities::cryptography::aes::decrypt(
 							std::string(enc.data(), enc.size() - 8), std::string(seed, 16),
 							demonware::get_decrypt_key());
 
-						byte_buffer serv(dec);
+						byte_buffer_view serv(dec);
 						serv.set_use_data_types(false);
 
 						uint32_t serv_size;
@@ -158,7 +158,7 @@ namespace demonware
 		}
 	}
 
-	void lobby_server::call_service(const uint8_t id, const std::string& data)
+	void lobby_server::call_service(const uint8_t id, const std::string_view data)
 	{
 		const auto& it = this->services_.find(id);
 
@@ -171,7 +171,7 @@ namespace demonware
 			logger::write(logger::LOG_TYPE_DEBUG, "[DW]: [lobby]: missing service '%s'", utilities::string::va("%d", id));
 
 			// return no error
-			byte_buffer buffer(data);
+			byte_buffer_view buffer(data);
 			uint8_t task_id;
 			buffer.read_ubyte(&task_id);
 
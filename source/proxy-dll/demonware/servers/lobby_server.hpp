@@ -28,6 +28,6 @@ namespace demonware
 		std::unordered_map<uint8_t, std::unique_ptr<service>> services_;
 
 		void handle(const std::string& packet) override;
-		void call_service(uint8_t id, const std::string& data);
+		void call_service(uint8_t id, const std::string_view data);
 	};
 }
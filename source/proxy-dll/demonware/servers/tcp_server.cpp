@@ -3,6 +3,49 @@
 
 namespace demonware
 {
+	namespace
+	{
+		std::atomic<uint64_t> ready_servers{0};
+
+		std::mutex ready_mutex{};
+		std::condition_variable ready_condition{};
+
+		void notify_ready()
+		{
+			{
+				std::lock_guard<std::mutex> _(ready_mutex);
+			}
+
+			ready_condition.notify_all();
+		}
+
+		class buffer_stream final : public output_stream
+		{
+		public:
+			explicit buffer_stream(std::string data) : data_(std::move(data))
+			{
+			}
+
+			size_t read(char* buf, const size_t size) override
+			{
+				const auto count = std::min(size, this->remaining());
+				std::memcpy(buf, this->data_.data() + this->offset_, count);
+				this->offset_ += count;
+
+				return count;
+			}
+
+			size_t remaining() const override
+			{
+				return this->data_.size() - this->offset_;
+			}
+
+		private:
+			std::string data_;
+			size_t offset_ = 0;
+		};
+	}
+
 	void tcp_server::handle_input(const char* buf, size_t size)
 	{
 		in_queue_.access([&](data_queue& queue)
@@ -13,31 +56,48 @@ namespace demonware
 
 	size_t tcp_server::handle_output(char* buf, size_t size)
 	{
-		if (out_queue_.get_raw().empty())
+		if (!this->pending_bytes_)
 		{
 			return 0;
 		}
 
 		return out_queue_.access<size_t>([&](stream_queue& queue)
 		{
-			for (size_t i = 0; i < size; ++i)
+			auto count = std::min(size, queue.data.size() - queue.offset);
+
+			std::memcpy(buf, queue.data.data() + queue.offset, count);
+			queue.offset += count;
+
+			if (queue.offset == queue.data.size())
 			{
-				if (queue.empty())
+				queue.data.clear();
+				queue.offset = 0;
+			}
+
+			while (count < size && !queue.streams.empty())
+			{
+				auto& stream = queue.streams.front();
+
+				const auto read = stream->read(buf + count, size - count);
+				count += read;
+				queue.stream_bytes -= read;
+
+				if (!read || !stream->remaining())
 				{
-					return i;
+					// a stream that can't make progress anymore is dropped
+					queue.stream_bytes -= stream->remaining();
+					queue.streams.pop();
 				}
-
-				buf[i] = queue.front();
-				queue.pop();
 			}
 
-			return size;
+			this->publish(queue);
+			return count;
 		});
 	}
 
 	bool tcp_server::pending_data()
 	{
-		return !this->out_queue_.get_raw().empty();
+		return this->pending_bytes_ != 0;
 	}
 
 	void tcp_server::frame()
@@ -47,6 +107,8 @@ namespace demonware
 			return;
 		}
 
+		this->batching_ = true;
+
 		while (true)
 		{
 			std::string packet{};
@@ -69,16 +131,126 @@ namespace demonware
 
 			this->handle(packet);
 		}
+
+		this->batching_ = false;
+		this->flush();
 	}
 
 	void tcp_server::send(const std::string& data)
 	{
+		this->pending_output_.append(data);
+
+		if (!this->batching_)
+		{
+			this->flush();
+		}
+	}
+
+	void tcp_server::flush()
+	{
+		if (this->pending_output_.empty())
+		{
+			return;
+		}
+
 		out_queue_.access([&](stream_queue& queue)
 		{
-			for (const auto& val : data)
+			if (!queue.streams.empty())
+			{
+				queue.stream_bytes += this->pending_output_.size();
+				queue.streams.push(std::make_unique<buffer_stream>(std::move(this->pending_output_)));
+			}
+			else if (queue.data.empty())
 			{
-				queue.push(val);
+				queue.data.swap(this->pending_output_);
+				queue.offset = 0;
 			}
+			else
+			{
+				queue.data.erase(0, queue.offset);
+				queue.offset = 0;
+				queue.data.append(this->pending_output_);
+			}
+
+			this->publish(queue);
 		});
+
+		this->pending_output_.clear();
+		notify_ready();
+	}
+
+	void tcp_server::send(std::unique_ptr<output_stream> stream)
+	{
+		// whatever was sent before has to go out first
+		this->flush();
+
+		if (!stream || !stream->remaining())
+		{
+			return;
+		}
+
+		out_queue_.access([&](stream_queue& queue)
+		{
+			queue.stream_bytes += stream->remaining();
+			queue.streams.push(std::move(stream));
+
+			this->publish(queue);
+		});
+
+		notify_ready();
+	}
+
+	void tcp_server::publish(const stream_queue& queue)
+	{
+		this->pending_bytes_ = queue.size();
+		this->set_ready(this->pending_bytes_ != 0);
+	}
+
+	uint64_t tcp_server::get_readiness_bit() const
+	{
+		return this->readiness_bit_;
+	}
+
+	uint64_t tcp_server::get_ready_servers()
+	{
+		return ready_servers.load(std::memory_order_acquire);
+	}
+
+	bool tcp_server::wait_for_ready_servers(const uint64_t servers, const std::optional<std::chrono::microseconds>& timeout)
+	{
+		const auto is_ready = [&]
+		{
+			return (get_ready_servers() & servers) != 0;
+		};
+
+		if (is_ready()) return true;
+
+		std::unique_lock<std::mutex> lock(ready_mutex);
+		if (!timeout)
+		{
+			ready_condition.wait(lock, is_ready);
+			return true;
+		}
+
+		return ready_condition.wait_for(lock, *timeout, is_ready);
+	}
+
+	uint64_t tcp_server::allocate_readiness_bit()
+	{
+		static std::atomic<uint32_t> server_count{0};
+
+		const auto index = server_count++;
+		if (index >= 64)
+		{
+			throw std::runtime_error("Too many tcp servers");
+		}
+
+		return 1ull << index;
+	}
+
+	void tcp_server::set_ready(const bool ready) const
+	{
+		if (ready) ready_servers.fetch_or(this->readiness_bit_, std::memory_order_release);
+		else ready_servers.fetch_and(~this->readiness_bit_, std::memory_order_release);
 	}
 }
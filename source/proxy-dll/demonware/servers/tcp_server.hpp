@@ -15,13 +15,34 @@ namespace demonware
 		bool pending_data();
 		void frame() override;
 
+		uint64_t get_readiness_bit() const;
+
+		// bitmap of servers with output waiting to be received
+		static uint64_t get_ready_servers();
+		// blocks until one of the given servers has output, or the timeout expires
+		static bool wait_for_ready_servers(uint64_t servers, const std::optional<std::chrono::microseconds>& timeout);
+
 	protected:
 		virtual void handle(const std::string& data) = 0;
 
 		void send(const std::string& data);
+		void send(std::unique_ptr<output_stream> stream);
 
 	private:
 		utilities::concurrency::container<data_queue> in_queue_;
 		utilities::concurrency::container<stream_queue> out_queue_;
+		std::atomic<size_t> pending_bytes_{0};
+
+		// replies produced while handling a frame's packets are queued in one go
+		std::string pending_output_{};
+		bool batching_ = false;
+
+		const uint64_t readiness_bit_ = allocate_readiness_bit();
+
+		static uint64_t allocate_readiness_bit();
+		void set_ready(bool ready) const;
+
+		void flush();
+		void publish(const stream_queue& queue);
 	};
 }
@@ -15,59 +15,81 @@ namespace demonware
 		});
 	}
 
-	size_t udp_server::handle_output(SOCKET socket, char* buf, size_t size, sockaddr* address, int* addrlen)
+	namespace
 	{
-		return out_queue_.access<size_t>([&](socket_queue_map& map) -> size_t
+		struct out_queues
 		{
-			const auto entry = map.find(socket);
-			if (entry == map.end())
-			{
-				return 0;
-			}
+			std::unordered_map<SOCKET, std::unique_ptr<udp_server::out_queue>> sockets{};
+			// kept alive and never reused, a reader still holding one can't get another socket's packets
+			std::vector<std::unique_ptr<udp_server::out_queue>> retired{};
+		};
 
-			auto& queue = entry->second;
+		utilities::concurrency::container<out_queues> socket_queues{};
+	}
 
-			if (queue.empty())
+	udp_server::out_queue* udp_server::get_out_queue(const SOCKET socket)
+	{
+		return socket_queues.access<out_queue*>([&](out_queues& queues)
+		{
+			auto& queue = queues.sockets[socket];
+			if (!queue)
 			{
-				return 0;
+				queue = std::make_unique<out_queue>();
 			}
 
-			auto data = std::move(queue.front());
-			queue.pop();
-
-			const auto copy_size = std::min(size, data.data.size());
-			std::memcpy(buf, data.data.data(), copy_size);
-			std::memcpy(address, &data.address, sizeof(data.address));
-			*addrlen = sizeof(data.address);
-
-			return copy_size;
+			return queue.get();
 		});
 	}
 
-	bool udp_server::pending_data(SOCKET socket)
+	void udp_server::release_out_queue(const SOCKET socket)
 	{
-		return this->out_queue_.access<bool>([&](const socket_queue_map& map)
+		socket_queues.access([&](out_queues& queues)
 		{
-			const auto entry = map.find(socket);
-			if (entry == map.end())
+			const auto queue = queues.sockets.find(socket);
+			if (queue == queues.sockets.end())
 			{
-				return false;
+				return;
 			}
 
-			return !entry->second.empty();
+			queue->second->clear();
+			queues.retired.emplace_back(std::move(queue->second));
+			queues.sockets.erase(queue);
 		});
 	}
 
-	void udp_server::send(const endpoint_data& endpoint, std::string data)
+	size_t udp_server::handle_output(out_queue& queue, char* buf, size_t size, sockaddr* address, int* addrlen)
 	{
-		out_queue_.access([&](socket_queue_map& map)
+		out_packet data{};
+		if (!queue.pop(data))
 		{
-			out_packet p;
-			p.data = std::move(data);
-			p.address = endpoint.address;
+			return 0;
+		}
+
+		const auto copy_size = std::min(size, data.data.size());
+		std::memcpy(buf, data.data.data(), copy_size);
+		std::memcpy(address, &data.address, sizeof(data.address));
+		*addrlen = sizeof(data.address);
 
-			map[endpoint.socket].emplace(std::move(p));
+		return copy_size;
+	}
+
+	void udp_server::send(const endpoint_data& endpoint, std::string data)
+	{
+		out_packet p;
+		p.data = std::move(data);
+		p.address = endpoint.address;
+
+		// pushed under the lock, a packet can't land in the queue after its socket was released
+		const auto pushed = socket_queues.access<bool>([&](out_queues& queues)
+		{
+			const auto queue = queues.sockets.find(endpoint.socket);
+			return queue != queues.sockets.end() && queue->second->push(std::move(p));
 		});
+
+		if (!pushed)
+		{
+			logger::write(logger::LOG_TYPE_DEBUG, "[DW]: [%s]: dropped packet, socket is closed or its queue is full", this->get_name().data());
+		}
 	}
 
 	void udp_server::frame()
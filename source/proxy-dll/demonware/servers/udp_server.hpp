@@ -27,14 +27,55 @@ namespace demonware
 			}
 		};
 
+		struct out_packet
+		{
+			std::string data;
+			sockaddr_in address;
+		};
+
+		// filled by the server thread, drained by whoever calls recvfrom on the socket,
+		// the readers are serialized so closesocket can clear it while it is being read
+		class out_queue
+		{
+		public:
+			bool push(out_packet packet)
+			{
+				return this->packets_.push(std::move(packet));
+			}
+
+			bool pop(out_packet& packet)
+			{
+				std::lock_guard _(this->read_mutex_);
+				return this->packets_.pop(packet);
+			}
+
+			void clear()
+			{
+				std::lock_guard _(this->read_mutex_);
+
+				out_packet packet{};
+				while (this->packets_.pop(packet))
+				{
+				}
+			}
+
+		private:
+			utilities::concurrency::spsc_queue<out_packet, 256> packets_{};
+			std::mutex read_mutex_{};
+		};
+
 		using base_server::base_server;
 
 		void handle_input(const char* buf, size_t size, endpoint_data endpoint);
-		size_t handle_output(SOCKET socket, char* buf, size_t size, sockaddr* address, int* addrlen);
-		bool pending_data(SOCKET socket);
-
 		void frame() override;
 
+		// every server answering on a socket shares its queue, it is created on first use
+		static out_queue* get_out_queue(SOCKET socket);
+		// drops the pending packets and retires the queue, a reader still holding it
+		// only finds it empty and a reused socket handle gets a new queue
+		static void release_out_queue(SOCKET socket);
+		static size_t handle_output(out_queue& queue, char* buf, size_t size, sockaddr* address, int* addrlen);
+
 	protected:
 		virtual void handle(const endpoint_data& endpoint, const std::string& data) = 0;
 		void send(const endpoint_data& endpoint, std::string data);
@@ -46,17 +87,8 @@ namespace demonware
 			endpoint_data endpoint;
 		};
 
-		struct out_packet
-		{
-			std::string data;
-			sockaddr_in address;
-		};
-
 		using in_queue = std::queue<in_packet>;
-		using out_queue = std::queue<out_packet>;
-		using socket_queue_map = std::unordered_map<SOCKET, out_queue>;
 
 		utilities::concurrency::container<in_queue> in_queue_;
-		utilities::concurrency::container<socket_queue_map> out_queue_;
 	};
 }
@@ -1,12 +1,13 @@
 #pragma once
 #include <utilities/string.hpp>
 #include "servers/service_server.hpp"
+#include "byte_buffer_view.hpp"
 
 namespace demonware
 {
 	class service
 	{
-		using callback_t = std::function<void(service_server*, byte_buffer*)>;
+		using callback_t = std::function<void(service_server*, byte_buffer_view*)>;
 
 		uint8_t id_;
 		std::string name_;
@@ -39,11 +40,11 @@ namespace demonware
 			return this->task_id_;
 		}
 
-		virtual void exec_task(service_server* server, const std::string& data)
+		virtual void exec_task(service_server* server, const std::string_view data)
 		{
 			std::lock_guard<std::mutex> _(this->mutex_);
 
-			byte_buffer buffer(data);
+			byte_buffer_view buffer(data);
 
 			buffer.read_ubyte(&this->task_id_);
 
@@ -2,6 +2,7 @@
 
 #include "bit_buffer.hpp"
 #include "byte_buffer.hpp"
+#include "byte_buffer_view.hpp"
 #include "data_types.hpp"
 #include "reply.hpp"
 #include "service.hpp"
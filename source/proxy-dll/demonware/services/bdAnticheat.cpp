@@ -12,35 +12,35 @@ namespace demonware
 		this->register_task(6, &bdAnticheat::reportExtendedAuthInfo);
 	}
 
-	void bdAnticheat::answerChallenges(service_server* server, byte_buffer* /*buffer*/) const
+	void bdAnticheat::answerChallenges(service_server* server, byte_buffer_view* /*buffer*/) const
 	{
 		// TODO: Read data as soon as needed
 		auto reply = server->create_reply(this->task_id());
 		reply->send();
 	}
 
-	void bdAnticheat::reportConsoleID(service_server* server, byte_buffer* /*buffer*/) const
+	void bdAnticheat::reportConsoleID(service_server* server, byte_buffer_view* /*buffer*/) const
 	{
 		// TODO: Read data as soon as needed
 		auto reply = server->create_reply(this->task_id());
 		reply->send();
 	}
 	
-	void bdAnticheat::reportConsoleDetails(service_server* server, byte_buffer* /*buffer*/) const
+	void bdAnticheat::reportConsoleDetails(service_server* server, byte_buffer_view* /*buffer*/) const
 	{
 		// TODO: Read data as soon as needed
 		auto reply = server->create_reply(this->task_id());
 		reply->send();
 	}
 
-	void bdAnticheat::answerTOTPChallenge(service_server* server, byte_buffer* /*buffer*/) const
+	void bdAnticheat::answerTOTPChallenge(service_server* server, byte_buffer_view* /*buffer*/) const
 	{
 		// TODO: Read data as soon as needed
 		auto reply = server->create_reply(this->task_id());
 		reply->send();
 	}
 
-	void bdAnticheat::reportExtendedAuthInfo(service_server* server, byte_buffer* /*buffer*/) const
+	void bdAnticheat::reportExtendedAuthInfo(service_server* server, byte_buffer_view* /*buffer*/) const
 	{
 		// TODO: Read data as soon as needed
 		auto reply = server->create_reply(this->task_id());
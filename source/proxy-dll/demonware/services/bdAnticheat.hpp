@@ -8,10 +8,10 @@ namespace demonware
 		bdAnticheat();
 
 	private:
-		void answerChallenges(service_server* server, byte_buffer* buffer) const;
-		void reportConsoleID(service_server* server, byte_buffer* buffer) const;
-		void reportConsoleDetails(service_server* server, byte_buffer* buffer) const;
-		void answerTOTPChallenge(service_server* server, byte_buffer* buffer) const;
-		void reportExtendedAuthInfo(service_server* server, byte_buffer* buffer) const;
+		void answerChallenges(service_server* server, byte_buffer_view* buffer) const;
+		void reportConsoleID(service_server* server, byte_buffer_view* buffer) const;
+		void reportConsoleDetails(service_server* server, byte_buffer_view* buffer) const;
+		void answerTOTPChallenge(service_server* server, byte_buffer_view* buffer) const;
+		void reportExtendedAuthInfo(service_server* server, byte_buffer_view* buffer) const;
 	};
 }
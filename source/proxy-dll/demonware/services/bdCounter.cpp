@@ -9,14 +9,14 @@ namespace demonware
 		this->register_task(2, &bdCounter::getCounterTotals);
 	}
 
-	void bdCounter::incrementCounters(service_server* server, byte_buffer* /*buffer*/) const
+	void bdCounter::incrementCounters(service_server* server, byte_buffer_view* /*buffer*/) const
 	{
 		// TODO:
 		auto reply = server->create_reply(this->task_id());
 		reply->send();
 	}
 
-	void bdCounter::getCounterTotals(service_server* server, byte_buffer* /*buffer*/) const
+	void bdCounter::getCounterTotals(service_server* server, byte_buffer_view* /*buffer*/) const
 	{
 		// TODO:
 		auto reply = server->create_reply(this->task_id());
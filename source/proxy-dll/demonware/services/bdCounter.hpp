@@ -8,7 +8,7 @@ namespace demonware
 		bdCounter();
 
 	private:
-		void incrementCounters(service_server* server, byte_buffer* buffer) const;
-		void getCounterTotals(service_server* server, byte_buffer* buffer) const;
+		void incrementCounters(service_server* server, byte_buffer_view* buffer) const;
+		void getCounterTotals(service_server* server, byte_buffer_view* buffer) const;
 	};
 }
@@ -10,7 +10,7 @@ namespace demonware
 		this->register_task(3, &bdDML::getUserHierarchicalData);
 	}
 
-	void bdDML::getUserHierarchicalData(service_server* server, byte_buffer* /*buffer*/) const
+	void bdDML::getUserHierarchicalData(service_server* server, byte_buffer_view* /*buffer*/) const
 	{
 		auto result = new bdDMLHierarchicalInfo;
 		result->country_code = "US";
@@ -8,9 +8,9 @@ namespace demonware
 		bdDML();
 
 	private:
-		void recordIP(service_server* server, byte_buffer* buffer) const;
-		void getUserData(service_server* server, byte_buffer* buffer) const;
-		void getUserHierarchicalData(service_server* server, byte_buffer* buffer) const;
-		void getUsersLastLogonData(service_server* server, byte_buffer* buffer) const;
+		void recordIP(service_server* server, byte_buffer_view* buffer) const;
+		void getUserData(service_server* server, byte_buffer_view* buffer) const;
+		void getUserHierarchicalData(service_server* server, byte_buffer_view* buffer) const;
+		void getUsersLastLogonData(service_server* server, byte_buffer_view* buffer) const;
 	};
 }
@@ -13,42 +13,42 @@ namespace demonware
 		this->register_task(6, &bdEventLog::initializeFiltering);
 	}
 
-	void bdEventLog::recordEvent(service_server* server, byte_buffer* /*buffer*/) const
+	void bdEventLog::recordEvent(service_server* server, byte_buffer_view* /*buffer*/) const
 	{
 		// TODO:
 		auto reply = server->create_reply(this->task_id());
 		reply->send();
 	}
 
-	void bdEventLog::recordEventBin(service_server* server, byte_buffer* /*buffer*/) const
+	void bdEventLog::recordEventBin(service_server* server, byte_buffer_view* /*buffer*/) const
 	{
 		// TODO:
 		auto reply = server->create_reply(this->task_id());
 		reply->send();
 	}
 
-	void bdEventLog::recordEvents(service_server* server, byte_buffer* /*buffer*/) const
+	void bdEventLog::recordEvents(service_server* server, byte_buffer_view* /*buffer*/) const
 	{
 		// TODO:
 		auto reply = server->create_reply(this->task_id());
 		reply->send();
 	}
 
-	void bdEventLog::recordEventsBin(service_server* server, byte_buffer* /*buffer*/) const
+	void bdEventLog::recordEventsBin(service_server* server, byte_buffer_view* /*buffer*/) const
 	{
 		// TODO:
 		auto reply = server->create_reply(this->task_id());
 		reply->send();
 	}
 
-	void bdEventLog::recordEventsMixed(service_server* server, byte_buffer* /*buffer*/) const
+	void bdEventLog::recordEventsMixed(service_server* server, byte_buffer_view* /*buffer*/) const
 	{
 		// TODO:
 		auto reply = server->create_reply(this->task_id());
 		reply->send();
 	}
 
-	void bdEventLog::initializeFiltering(service_server* server, byte_buffer* /*buffer*/) const
+	void bdEventLog::initializeFiltering(service_server* server, byte_buffer_view* /*buffer*/) const
 	{
 		// TODO:
 		auto reply = server->create_reply(this->task_id());
@@ -8,11 +8,11 @@ namespace demonware
 		bdEventLog();
 
 	private:
-		void recordEvent(service_server* server, byte_buffer* buffer) const;
-		void recordEventBin(service_server* server, byte_buffer* buffer) const;
-		void recordEvents(service_server* server, byte_buffer* buffer) const;
-		void recordEventsBin(service_server* server, byte_buffer* buffer) const;
-		void recordEventsMixed(service_server* server, byte_buffer* buffer) const;
-		void initializeFiltering(service_server* server, byte_buffer* buffer) const;
+		void recordEvent(service_server* server, byte_buffer_view* buffer) const;
+		void recordEventBin(service_server* server, byte_buffer_view* buffer) const;
+		void recordEvents(service_server* server, byte_buffer_view* buffer) const;
+		void recordEventsBin(service_server* server, byte_buffer_view* buffer) const;
+		void recordEventsMixed(service_server* server, byte_buffer_view* buffer) const;
+		void initializeFiltering(service_server* server, byte_buffer_view* buffer) const;
 	};
 }
@@ -11,28 +11,28 @@ namespace demonware
 		this->register_task(4, &bdGroup::getGroupCounts);
 	}
 
-	void bdGroup::setGroups(service_server* server, byte_buffer* /*buffer*/) const
+	void bdGroup::setGroups(service_server* server, byte_buffer_view* /*buffer*/) const
 	{
 		// TODO:
 		auto reply = server->create_reply(this->task_id());
 		reply->send();
 	}
 
-	void bdGroup::setGroupsForEntity(service_server* server, byte_buffer* /*buffer*/) const
+	void bdGroup::setGroupsForEntity(service_server* server, byte_buffer_view* /*buffer*/) const
 	{
 		// TODO:
 		auto reply = server->create_reply(this->task_id());
 		reply->send();
 	}
 
-	void bdGroup::getEntityGroups(service_server* server, byte_buffer* /*buffer*/) const
+	void bdGroup::getEntityGroups(service_server* server, byte_buffer_view* /*buffer*/) const
 	{
 		// TODO:
 		auto reply = server->create_reply(this->task_id());
 		reply->send();
 	}
 
-	void bdGroup::getGroupCounts(service_server* server, byte_buffer* /*buffer*/) const
+	void bdGroup::getGroupCounts(service_server* server, byte_buffer_view* /*buffer*/) const
 	{
 		// TODO:
 		auto reply = server->create_reply(this->task_id());
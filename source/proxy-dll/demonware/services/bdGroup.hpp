@@ -8,9 +8,9 @@ namespace demonware
 		bdGroup();
 
 	private:
-		void setGroups(service_server* server, byte_buffer* buffer) const;
-		void setGroupsForEntity(service_server* server, byte_buffer* buffer) const;
-		void getEntityGroups(service_server* server, byte_buffer* buffer) const;
-		void getGroupCounts(service_server* server, byte_buffer* buffer) const;
+		void setGroups(service_server* server, byte_buffer_view* buffer) const;
+		void setGroupsForEntity(service_server* server, byte_buffer_view* buffer) const;
+		void getEntityGroups(service_server* server, byte_buffer_view* buffer) const;
+		void getGroupCounts(service_server* server, byte_buffer_view* buffer) const;
 	};
 }
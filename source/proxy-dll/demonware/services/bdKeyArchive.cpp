@@ -1,8 +1,62 @@
 #include <std_include.hpp>
 #include "../services.hpp"
+#include "../key_store.hpp"
+#include "component/platform.hpp"
+
+#include <utilities/string.hpp>
 
 namespace demonware
 {
+	namespace
+	{
+		// request layouts as they are guessed, none of them is confirmed yet, every field is typed:
+		//   write                  uint16 category, pairs until the end, written for the local user
+		//   read                   uint64 entity id, uint16 category, uint16 indexes until the end
+		//   readAll                uint64 entity id, uint16 category
+		//   readMultipleEntityIDs  uint16 category, uint16 index, uint64 entity ids until the end
+		//   writeMultipleEntityIDs uint16 category, (uint64 entity id, pair) until the end
+		// a pair is an uint16 index and an int64 value, optionally followed by an uint32 write type
+		bool read_update(byte_buffer_view* buffer, const uint64_t entity_id, const uint16_t category, key_store::update* update)
+		{
+			uint16_t index{};
+			int64_t value{};
+
+			if (!buffer->read_uint16(&index) || !buffer->read_int64(&value)) return false;
+
+			update->target = { { entity_id, category, index }, value };
+			update->type = key_store::WRITE_REPLACE;
+
+			// the type tag tells an uint32 write type from the uint16 index of the next pair
+			auto probe = *buffer;
+			uint32_t type{};
+			if (probe.read_uint32(&type))
+			{
+				if (type > key_store::WRITE_MIN) return false;
+
+				update->type = static_cast<key_store::write_type>(type);
+				*buffer = probe;
+			}
+
+			return true;
+		}
+
+		// a request that doesn't fit its layout is logged and answered with an empty reply like the old stub
+		void send_unparsed(service_server* server, const byte_buffer_view* buffer, const char* task, const uint8_t task_id)
+		{
+			logger::write(logger::LOG_TYPE_DEBUG, "[DW]: [bdKeyArchive::%s]: unexpected request: %s\n", task, utilities::string::dump_hex(std::string{ buffer->get_buffer() }).data());
+			server->create_reply(task_id)->send();
+		}
+
+		void add_pair(const std::shared_ptr<service_reply>& reply, const uint16_t index, const int64_t value)
+		{
+			auto result = new bdKeyValuePair;
+			result->m_index = index;
+			result->m_value = value;
+
+			reply->add(result);
+		}
+	}
+
 	bdKeyArchive::bdKeyArchive() : service(15, "bdKeyArchive")
 	{
 		this->register_task(1, &bdKeyArchive::write);
@@ -12,36 +66,144 @@ namespace demonware
 		this->register_task(6, &bdKeyArchive::writeMultipleEntityIDs);
 	}
 
-	void bdKeyArchive::write(service_server* server, byte_buffer* /*buffer*/) const
+	void bdKeyArchive::write(service_server* server, byte_buffer_view* buffer) const
 	{
-		// TODO:
+		uint16_t category{};
+		if (!buffer->read_uint16(&category))
+		{
+			return send_unparsed(server, buffer, "write", this->task_id());
+		}
+
+		const auto entity_id = platform::bnet_get_userid();
+
+		// nothing is written unless the whole request is valid
+		std::vector<key_store::update> updates{};
+		key_store::update update{};
+		while (buffer->has_more_data())
+		{
+			if (!read_update(buffer, entity_id, category, &update))
+			{
+				return send_unparsed(server, buffer, "write", this->task_id());
+			}
+
+			updates.push_back(update);
+		}
+
+		if (!get_key_store().write(updates))
+		{
+			server->create_reply(this->task_id(), 102/*BD_EXCEPTION_IN_DB*/)->send();
+			return;
+		}
+
 		auto reply = server->create_reply(this->task_id());
 		reply->send();
 	}
 
-	void bdKeyArchive::read(service_server* server, byte_buffer* /*buffer*/) const
+	void bdKeyArchive::read(service_server* server, byte_buffer_view* buffer) const
 	{
-		// TODO:
+		uint64_t entity_id{}; uint16_t category{};
+		if (!buffer->read_uint64(&entity_id) || !buffer->read_uint16(&category))
+		{
+			return send_unparsed(server, buffer, "read", this->task_id());
+		}
+
 		auto reply = server->create_reply(this->task_id());
+
+		uint16_t index{};
+		while (buffer->has_more_data())
+		{
+			if (!buffer->read_uint16(&index))
+			{
+				return send_unparsed(server, buffer, "read", this->task_id());
+			}
+
+			const auto value = get_key_store().read({ entity_id, category, index });
+			if (value) add_pair(reply, index, *value);
+		}
+
 		reply->send();
 	}
 
-	void bdKeyArchive::readAll(service_server* server, byte_buffer* /*buffer*/) const
+	void bdKeyArchive::readAll(service_server* server, byte_buffer_view* buffer) const
 	{
-		// TODO:
+		uint64_t entity_id{}; uint16_t category{};
+		if (!buffer->read_uint64(&entity_id) || !buffer->read_uint16(&category))
+		{
+			return send_unparsed(server, buffer, "readAll", this->task_id());
+		}
+
 		auto reply = server->create_reply(this->task_id());
+
+		for (const auto& entry : get_key_store().read_all(entity_id, category))
+		{
+			add_pair(reply, entry.key.index, entry.value);
+		}
+
 		reply->send();
 	}
 
-	void bdKeyArchive::readMultipleEntityIDs(service_server* server, byte_buffer* /*buffer*/) const
+	void bdKeyArchive::readMultipleEntityIDs(service_server* server, byte_buffer_view* buffer) const
 	{
-		// TODO:
+		uint16_t category{}, index{};
+		if (!buffer->read_uint16(&category) || !buffer->read_uint16(&index))
+		{
+			return send_unparsed(server, buffer, "readMultipleEntityIDs", this->task_id());
+		}
+
 		auto reply = server->create_reply(this->task_id());
+
+		// answered from memory, nothing here touches the disk
+		uint64_t entity_id{};
+		while (buffer->has_more_data())
+		{
+			if (!buffer->read_uint64(&entity_id))
+			{
+				return send_unparsed(server, buffer, "readMultipleEntityIDs", this->task_id());
+			}
+
+			const auto value = get_key_store().read({ entity_id, category, index });
+			if (!value) continue;
+
+			auto result = new bdEntityIDKeyValuePair;
+			result->m_entityID = entity_id;
+			result->m_index = index;
+			result->m_value = *value;
+
+			reply->add(result);
+		}
+
 		reply->send();
 	}
-	void bdKeyArchive::writeMultipleEntityIDs(service_server* server, byte_buffer* /*buffer*/) const
+
+	void bdKeyArchive::writeMultipleEntityIDs(service_server* server, byte_buffer_view* buffer) const
 	{
-		// TODO:
+		uint16_t category{};
+		if (!buffer->read_uint16(&category))
+		{
+			return send_unparsed(server, buffer, "writeMultipleEntityIDs", this->task_id());
+		}
+
+		// every entity's pairs go to the log as a single batch
+		std::vector<key_store::update> updates{};
+
+		uint64_t entity_id{};
+		key_store::update update{};
+		while (buffer->has_more_data())
+		{
+			if (!buffer->read_uint64(&entity_id) || !read_update(buffer, entity_id, category, &update))
+			{
+				return send_unparsed(server, buffer, "writeMultipleEntityIDs", this->task_id());
+			}
+
+			updates.push_back(update);
+		}
+
+		if (!get_key_store().write(updates))
+		{
+			server->create_reply(this->task_id(), 102/*BD_EXCEPTION_IN_DB*/)->send();
+			return;
+		}
+
 		auto reply = server->create_reply(this->task_id());
 		reply->send();
 	}
@@ -8,10 +8,10 @@ namespace demonware
 		bdKeyArchive();
 
 	private:
-		void write(service_server* server, byte_buffer* buffer) const;
-		void read(service_server* server, byte_buffer* buffer) const;
-		void readAll(service_server* server, byte_buffer* buffer) const;
-		void readMultipleEntityIDs(service_server* server, byte_buffer* buffer) const;
-		void writeMultipleEntityIDs(service_server* server, byte_buffer* buffer) const;
+		void write(service_server* server, byte_buffer_view* buffer) const;
+		void read(service_server* server, byte_buffer_view* buffer) const;
+		void readAll(service_server* server, byte_buffer_view* buffer) const;
+		void readMultipleEntityIDs(service_server* server, byte_buffer_view* buffer) const;
+		void writeMultipleEntityIDs(service_server* server, byte_buffer_view* buffer) const;
 	};
 }
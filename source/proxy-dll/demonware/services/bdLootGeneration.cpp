@@ -9,7 +9,7 @@ namespace demonware
 		this->register_task(2, &bdLootGeneration::getPlayerState);
 	}
 
-	void bdLootGeneration::getPlayerState(service_server* server, byte_buffer* buffer) const
+	void bdLootGeneration::getPlayerState(service_server* server, byte_buffer_view* buffer) const
 	{
 		auto reply = server->create_structed_reply(this->task_id());
 		reply->send(""); // Un-handled
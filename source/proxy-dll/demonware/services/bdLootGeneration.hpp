@@ -8,6 +8,6 @@ namespace demonware
 		bdLootGeneration();
 
 	private:
-		void getPlayerState(service_server* server, byte_buffer* buffer) const;
+		void getPlayerState(service_server* server, byte_buffer_view* buffer) const;
 	};
 }
@@ -9,14 +9,14 @@ namespace demonware
 		this->register_task(7, &bdMarketingComms::reportMessagesViewed);
 	}
 
-	void bdMarketingComms::getMessages(service_server* server, byte_buffer* /*buffer*/) const
+	void bdMarketingComms::getMessages(service_server* server, byte_buffer_view* /*buffer*/) const
 	{
 		// TODO:
 		auto reply = server->create_reply(this->task_id());
 		reply->send();
 	}
 
-	void bdMarketingComms::reportMessagesViewed(service_server* server, byte_buffer* /*buffer*/) const
+	void bdMarketingComms::reportMessagesViewed(service_server* server, byte_buffer_view* /*buffer*/) const
 	{
 		// TODO:
 		auto reply = server->create_reply(this->task_id());
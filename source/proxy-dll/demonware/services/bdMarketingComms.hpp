@@ -8,7 +8,7 @@ namespace demonware
 		bdMarketingComms();
 
 	private:
-		void getMessages(service_server* server, byte_buffer* buffer) const;
-		void reportMessagesViewed(service_server* server, byte_buffer* buffer) const;
+		void getMessages(service_server* server, byte_buffer_view* buffer) const;
+		void reportMessagesViewed(service_server* server, byte_buffer_view* buffer) const;
 	};
 }
@@ -10,14 +10,14 @@ namespace demonware
 		this->register_task(245, &bdMarketplace::getBalancesV3);
 	}
 
-	void bdMarketplace::getInventoryPaginated(service_server* server, byte_buffer* /*buffer*/) const
+	void bdMarketplace::getInventoryPaginated(service_server* server, byte_buffer_view* /*buffer*/) const
 	{
 		// TODO:
 		auto reply = server->create_reply(this->task_id());
 		reply->send();
 	}
 
-	void bdMarketplace::getBalancesV3(service_server* server, byte_buffer* /*buffer*/) const
+	void bdMarketplace::getBalancesV3(service_server* server, byte_buffer_view* /*buffer*/) const
 	{
 		// TODO:
 		auto reply = server->create_structed_reply(this->task_id());
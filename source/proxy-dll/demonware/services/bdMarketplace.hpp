@@ -8,7 +8,7 @@ namespace demonware
 		bdMarketplace();
 
 	private:
-		void getInventoryPaginated(service_server* server, byte_buffer* buffer) const;
-		void getBalancesV3(service_server* server, byte_buffer* buffer) const;
+		void getInventoryPaginated(service_server* server, byte_buffer_view* buffer) const;
+		void getBalancesV3(service_server* server, byte_buffer_view* buffer) const;
 	};
 }
@@ -25,46 +25,46 @@ namespace demonware
 		this->register_task(16, &bdObjectStore::getPublisherObjectMetadatas); // Un-handled; Not needed if user already has LPC
 	}
 
-	void bdObjectStore::getUserObject(service_server* server, byte_buffer* buffer) const
+	void bdObjectStore::getUserObject(service_server* server, byte_buffer_view* buffer) const
 	{
 		auto reply = server->create_reply(this->task_id(), 20000/*BD_OBJECTSTORE_PROXY_OBJECT_NOT_FOUND*/);
 		reply->send();
 	}
 
-	void bdObjectStore::getPublisherObject(service_server* server, byte_buffer* buffer) const
+	void bdObjectStore::getPublisherObject(service_server* server, byte_buffer_view* buffer) const
 	{
 		auto reply = server->create_reply(this->task_id(), 20000/*BD_OBJECTSTORE_PROXY_OBJECT_NOT_FOUND*/);
 		reply->send();
 	}
 
-	void bdObjectStore::listUserObjects(service_server* server, byte_buffer* buffer) const
+	void bdObjectStore::listUserObjects(service_server* server, byte_buffer_view* buffer) const
 	{
-		std::string response_json = generate_user_objects_list_json();
-		std::string response_buff = serialize_objectstore_structed_buffer(response_json);
+		objectstore_payload payload;
+		generate_user_objects_list_json(&payload);
 
 		auto reply = server->create_structed_reply(this->task_id());
-		reply->send(response_buff);
+		reply->send(payload.finalize());
 	}
 
-	void bdObjectStore::getUserObjectCounts(service_server* server, byte_buffer* buffer) const
+	void bdObjectStore::getUserObjectCounts(service_server* server, byte_buffer_view* buffer) const
 	{
-		std::string response_json = generate_user_objects_count_json();
-		std::string response_buff = serialize_objectstore_structed_buffer(response_json);
+		objectstore_payload payload;
+		generate_user_objects_count_json(&payload);
 
 		auto reply = server->create_structed_reply(this->task_id());
-		reply->send(response_buff);
+		reply->send(payload.finalize());
 	}
 
-	void bdObjectStore::listPublisherObjectsByCategory(service_server* server, byte_buffer* buffer) const
+	void bdObjectStore::listPublisherObjectsByCategory(service_server* server, byte_buffer_view* buffer) const
 	{
-		std::string response_json = generate_publisher_objects_list_json("");
-		std::string response_buff = serialize_objectstore_structed_buffer(response_json);
+		objectstore_payload payload;
+		generate_publisher_objects_list_json(&payload, "");
 
 		auto reply = server->create_structed_reply(this->task_id());
-		reply->send(response_buff);
+		reply->send(payload.finalize());
 	}
 
-	void bdObjectStore::getUserObjectsVectorized(service_server* server, byte_buffer* buffer) const
+	void bdObjectStore::getUserObjectsVectorized(service_server* server, byte_buffer_view* buffer) const
 	{
 		std::string structed_data;
 		buffer->read_struct(&structed_data);
@@ -84,20 +84,20 @@ namespace demonware
 			requested_objects_list.push_back({ std::format("bnet-{}", platform::bnet_get_userid())/*requested_objects_list_json[i]["owner"].GetString()*/, requested_objects_list_json[i]["name"].GetString() });
 		}
 
-		std::string response_json = deliver_user_objects_vectorized_json(requested_objects_list);
-		std::string response_buff = serialize_objectstore_structed_buffer(response_json);
+		objectstore_payload payload;
+		deliver_user_objects_vectorized_json(&payload, requested_objects_list);
 
 		auto reply = server->create_structed_reply(this->task_id());
-		reply->send(response_buff);
+		reply->send(payload.finalize());
 	}
 
-	void bdObjectStore::getPublisherObjectMetadatas(service_server* server, byte_buffer* buffer) const
+	void bdObjectStore::getPublisherObjectMetadatas(service_server* server, byte_buffer_view* buffer) const
 	{
 		auto reply = server->create_structed_reply(this->task_id());
 		reply->send(""); // Un-handled
 	}
 
-	void bdObjectStore::uploadUserObject(service_server* server, byte_buffer* buffer) const
+	void bdObjectStore::uploadUserObject(service_server* server, byte_buffer_view* buffer) const
 	{
 		std::string structed_data;
 		buffer->read_struct(&structed_data);
@@ -117,14 +117,14 @@ namespace demonware
 		else
 			logger::write(logger::LOG_TYPE_DEBUG, "[bdObjectStore::uploadUserObject] saved user file '%s'", file.data());
 
-		std::string response_json = construct_file_upload_result_json(file);
-		std::string response_buff = serialize_objectstore_structed_buffer(response_json);
+		objectstore_payload payload;
+		construct_file_upload_result_json(&payload, file);
 
 		auto reply = server->create_structed_reply(this->task_id());
-		reply->send(response_buff);
+		reply->send(payload.finalize());
 	}
 
-	void bdObjectStore::uploadUserObjectsVectorized(service_server* server, byte_buffer* buffer) const
+	void bdObjectStore::uploadUserObjectsVectorized(service_server* server, byte_buffer_view* buffer) const
 	{
 		std::string structed_data;
 		buffer->read_struct(&structed_data);
@@ -157,11 +157,11 @@ namespace demonware
 				logger::write(logger::LOG_TYPE_DEBUG, "[bdObjectStore::uploadUserObjectsVectorized] saved user file '%s'", name.GetString());
 		}
 
-		std::string response_json = construct_vectorized_upload_list_json(uploaded_objects_list);
-		std::string response_buff = serialize_objectstore_structed_buffer(response_json);
+		objectstore_payload payload;
+		construct_vectorized_upload_list_json(&payload, uploaded_objects_list);
 
 		auto reply = server->create_structed_reply(this->task_id());
-		reply->send(response_buff);
+		reply->send(payload.finalize());
 	}
 }
 
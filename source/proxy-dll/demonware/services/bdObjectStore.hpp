@@ -8,14 +8,14 @@ namespace demonware
 		bdObjectStore();
 
 	private:
-		void getUserObject(service_server* server, byte_buffer* buffer) const;
-		void getPublisherObject(service_server* server, byte_buffer* buffer) const;
-		void listUserObjects(service_server* server, byte_buffer* buffer) const;
-		void getUserObjectCounts(service_server* server, byte_buffer* buffer) const;
-		void listPublisherObjectsByCategory(service_server* server, byte_buffer* buffer) const;
-		void getUserObjectsVectorized(service_server* server, byte_buffer* buffer) const;
-		void getPublisherObjectMetadatas(service_server* server, byte_buffer* buffer) const;
-		void uploadUserObject(service_server* server, byte_buffer* buffer) const;
-		void uploadUserObjectsVectorized(service_server* server, byte_buffer* buffer) const;
+		void getUserObject(service_server* server, byte_buffer_view* buffer) const;
+		void getPublisherObject(service_server* server, byte_buffer_view* buffer) const;
+		void listUserObjects(service_server* server, byte_buffer_view* buffer) const;
+		void getUserObjectCounts(service_server* server, byte_buffer_view* buffer) const;
+		void listPublisherObjectsByCategory(service_server* server, byte_buffer_view* buffer) const;
+		void getUserObjectsVectorized(service_server* server, byte_buffer_view* buffer) const;
+		void getPublisherObjectMetadatas(service_server* server, byte_buffer_view* buffer) const;
+		void uploadUserObject(service_server* server, byte_buffer_view* buffer) const;
+		void uploadUserObjectsVectorized(service_server* server, byte_buffer_view* buffer) const;
 	};
 }
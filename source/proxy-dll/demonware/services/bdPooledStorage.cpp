@@ -22,7 +22,7 @@ namespace demonware
 		this->register_task(22, &bdPooledStorage::_preDownloadMultiPart);
 	}
 
-	void bdPooledStorage::getPooledMetaDataByID(service_server* server, byte_buffer* buffer) const
+	void bdPooledStorage::getPooledMetaDataByID(service_server* server, byte_buffer_view* buffer) const
 	{
 		std::vector<uint64_t> requested_files;
 		buffer->read_array(10, &requested_files);
@@ -31,14 +31,12 @@ namespace demonware
 
 		for (auto fileID : requested_files)
 		{
-			std::string metafile = fileshare::get_metadata_path(fileshare::get_file_name(fileID));
-
-			fileshare::FileMetadata metadata;
-			if (metadata.ReadMetaDataJson(metafile, metadata.FILE_STATE_DESCRIBED)
-				&& utilities::io::file_exists(fileshare::get_file_path(metadata.ioFileName)))
+			auto metadata = fileshare::get_catalog().find(fileID);
+			if (metadata && metadata->state == fileshare::FileMetadata::FILE_STATE_DESCRIBED
+				&& utilities::io::file_exists(fileshare::get_file_path(metadata->ioFileName)))
 			{
 				auto taskResult = new bdFileMetaData;
-				metadata.MetadataTaskResult(taskResult, false);
+				metadata->MetadataTaskResult(taskResult, false);
 
 				reply->add(taskResult);
 			}
@@ -47,7 +45,7 @@ namespace demonware
 		reply->send();
 	}
 
-	void bdPooledStorage::_preUpload(service_server* server, byte_buffer* buffer) const
+	void bdPooledStorage::_preUpload(service_server* server, byte_buffer_view* buffer) const
 	{
 		std::string filename; uint16_t category;
 		buffer->read_string(&filename);
@@ -66,7 +64,8 @@ namespace demonware
 		metadata.category = static_cast<fileshare::fileshareCategory_e>(category);
 		metadata.ioFileName = fileshare::get_file_name(metadata.file.id, metadata.category);
 
-		metadata.WriteMetaDataJson(fileshare::get_metadata_path(metadata.ioFileName), metadata.FILE_STATE_UPLOADING);
+		metadata.state = metadata.FILE_STATE_UPLOADING;
+		fileshare::get_catalog().put(metadata);
 
 		auto reply = server->create_reply(this->task_id());
 
@@ -80,7 +79,7 @@ namespace demonware
 		reply->send();
 	}
 
-	void bdPooledStorage::_postUploadFile(service_server* server, byte_buffer* buffer) const
+	void bdPooledStorage::_postUploadFile(service_server* server, byte_buffer_view* buffer) const
 	{
 		uint64_t fileID; uint32_t fileSize;
 		uint16_t serverType; std::string serverIndex;
@@ -90,15 +89,14 @@ namespace demonware
 		buffer->read_string(&serverIndex);
 		buffer->read_uint32(&fileSize);
 
-		auto metafile = fileshare::get_metadata_path(fileshare::get_file_name(fileID));
-
-		fileshare::FileMetadata metadata;
-		if (metadata.ReadMetaDataJson(metafile)) {
-			auto ioSize = utilities::io::file_size(fileshare::get_file_path(metadata.ioFileName));
-			metadata.file.size = fileSize;
-			metadata.ioFileSize = static_cast<uint32_t>(ioSize);
+		auto metadata = fileshare::get_catalog().find(fileID);
+		if (metadata) {
+			auto ioSize = utilities::io::file_size(fileshare::get_file_path(metadata->ioFileName));
+			metadata->file.size = fileSize;
+			metadata->ioFileSize = static_cast<uint32_t>(ioSize);
+			metadata->state = metadata->FILE_STATE_UPLOADED;
 
-			metadata.WriteMetaDataJson(metafile, metadata.FILE_STATE_UPLOADED);
+			fileshare::get_catalog().put(*metadata);
 		}
 
 		auto reply = server->create_reply(this->task_id());
@@ -110,28 +108,26 @@ namespace demonware
 		reply->send();
 	}
 
-	void bdPooledStorage::remove(service_server* server, byte_buffer* /*buffer*/) const
+	void bdPooledStorage::remove(service_server* server, byte_buffer_view* /*buffer*/) const
 	{
 		// TODO:
 		auto reply = server->create_reply(this->task_id());
 		reply->send();
 	}
 
-	void bdPooledStorage::_preDownload(service_server* server, byte_buffer* buffer) const
+	void bdPooledStorage::_preDownload(service_server* server, byte_buffer_view* buffer) const
 	{
 		uint64_t fileID;
 		buffer->read_uint64(&fileID);
 
-		std::string metafile = fileshare::get_metadata_path(fileshare::get_file_name(fileID));
-
-		fileshare::FileMetadata metadata;
-		if (metadata.ReadMetaDataJson(metafile, metadata.FILE_STATE_DESCRIBED)
-			&& utilities::io::file_exists(fileshare::get_file_path(metadata.ioFileName)))
+		auto metadata = fileshare::get_catalog().find(fileID);
+		if (metadata && metadata->state == fileshare::FileMetadata::FILE_STATE_DESCRIBED
+			&& utilities::io::file_exists(fileshare::get_file_path(metadata->ioFileName)))
 		{
 			auto reply = server->create_reply(this->task_id());
 
 			auto taskResult = new bdFileMetaData;
-			metadata.MetadataTaskResult(taskResult, true);
+			metadata->MetadataTaskResult(taskResult, true);
 			reply->add(taskResult);
 			
 			reply->send();
@@ -143,54 +139,53 @@ namespace demonware
 		}
 	}
 
-	void bdPooledStorage::_preUploadSummary(service_server* server, byte_buffer* buffer) const
+	void bdPooledStorage::_preUploadSummary(service_server* server, byte_buffer_view* buffer) const
 	{
 		uint64_t fileID{}; uint32_t fileSize{};
 		buffer->read_uint64(&fileID);
 		buffer->read_uint32(&fileSize);
 
-		auto metafile = fileshare::get_metadata_path(fileshare::get_file_name(fileID));
-
-		fileshare::FileMetadata metadata;
-		if (metadata.ReadMetaDataJson(metafile)) {
-			buffer->read_blob(&metadata.ddlMetadata);
-			buffer->read_array(10, &metadata.tags);
+		auto metadata = fileshare::get_catalog().find(fileID);
+		if (metadata) {
+			buffer->read_blob(&metadata->ddlMetadata);
+			buffer->read_array(10, &metadata->tags);
+			metadata->state = metadata->FILE_STATE_DESCRIBED;
 
-			metadata.WriteMetaDataJson(metafile, metadata.FILE_STATE_DESCRIBED);
+			fileshare::get_catalog().put(*metadata);
 		}
 
 		auto reply = server->create_reply(this->task_id(), 108/*BD_SERVICE_NOT_AVAILABLE*/);
 		reply->send();
 	}
 
-	void bdPooledStorage::_postUploadSummary(service_server* server, byte_buffer* /*buffer*/) const
+	void bdPooledStorage::_postUploadSummary(service_server* server, byte_buffer_view* /*buffer*/) const
 	{
 		auto reply = server->create_reply(this->task_id());
 		reply->send();
 	}
 
-	void bdPooledStorage::_preDownloadSummary(service_server* server, byte_buffer* /*buffer*/) const
+	void bdPooledStorage::_preDownloadSummary(service_server* server, byte_buffer_view* /*buffer*/) const
 	{
 		// TODO:
 		auto reply = server->create_reply(this->task_id());
 		reply->send();
 	}
 
-	void bdPooledStorage::_preUploadMultiPart(service_server* server, byte_buffer* /*buffer*/) const
+	void bdPooledStorage::_preUploadMultiPart(service_server* server, byte_buffer_view* /*buffer*/) const
 	{
 		// TODO:
 		auto reply = server->create_reply(this->task_id());
 		reply->send();
 	}
 
-	void bdPooledStorage::_postUploadMultiPart(service_server* server, byte_buffer* /*buffer*/) const
+	void bdPooledStorage::_postUploadMultiPart(service_server* server, byte_buffer_view* /*buffer*/) const
 	{
 		// TODO:
 		auto reply = server->create_reply(this->task_id());
 		reply->send();
 	}
 
-	void bdPooledStorage::_preDownloadMultiPart(service_server* server, byte_buffer* /*buffer*/) const
+	void bdPooledStorage::_preDownloadMultiPart(service_server* server, byte_buffer_view* /*buffer*/) const
 	{
 		// TODO:
 		auto reply = server->create_reply(this->task_id());
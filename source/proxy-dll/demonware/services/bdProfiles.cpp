@@ -18,7 +18,7 @@ namespace demonware
 		this->register_task(8, &bdProfiles::setPublicInfoByUserID);
 	}
 
-	void bdProfiles::getPublicInfos(service_server* server, byte_buffer* buffer) const
+	void bdProfiles::getPublicInfos(service_server* server, byte_buffer_view* buffer) const
 	{
 		uint64_t entity_id;
 		buffer->read_uint64(&entity_id);
@@ -40,7 +40,7 @@ namespace demonware
 		}
 	}
 
-	void bdProfiles::setPublicInfo(service_server* server, byte_buffer* buffer) const
+	void bdProfiles::setPublicInfo(service_server* server, byte_buffer_view* buffer) const
 	{
 		int32_t version; std::string ddl;
 		buffer->read_int32(&version);
@@ -52,42 +52,42 @@ namespace demonware
 		reply->send();
 	}
 
-	void bdProfiles::getPrivateInfo(service_server* server, byte_buffer* /*buffer*/) const
+	void bdProfiles::getPrivateInfo(service_server* server, byte_buffer_view* /*buffer*/) const
 	{
 		// TODO:
 		auto reply = server->create_reply(this->task_id());
 		reply->send();
 	}
 
-	void bdProfiles::setPrivateInfo(service_server* server, byte_buffer* /*buffer*/) const
+	void bdProfiles::setPrivateInfo(service_server* server, byte_buffer_view* /*buffer*/) const
 	{
 		// TODO:
 		auto reply = server->create_reply(this->task_id());
 		reply->send();
 	}
 
-	void bdProfiles::deleteProfile(service_server* server, byte_buffer* /*buffer*/) const
+	void bdProfiles::deleteProfile(service_server* server, byte_buffer_view* /*buffer*/) const
 	{
 		// TODO:
 		auto reply = server->create_reply(this->task_id());
 		reply->send();
 	}
 
-	void bdProfiles::setPrivateInfoByUserID(service_server* server, byte_buffer* /*buffer*/) const
+	void bdProfiles::setPrivateInfoByUserID(service_server* server, byte_buffer_view* /*buffer*/) const
 	{
 		// TODO:
 		auto reply = server->create_reply(this->task_id());
 		reply->send();
 	}
 
-	void bdProfiles::getPrivateInfoByUserID(service_server* server, byte_buffer* /*buffer*/) const
+	void bdProfiles::getPrivateInfoByUserID(service_server* server, byte_buffer_view* /*buffer*/) const
 	{
 		// TODO:
 		auto reply = server->create_reply(this->task_id());
 		reply->send();
 	}
 
-	void bdProfiles::setPublicInfoByUserID(service_server* server, byte_buffer* /*buffer*/) const
+	void bdProfiles::setPublicInfoByUserID(service_server* server, byte_buffer_view* /*buffer*/) const
 	{
 		// TODO:
 		auto reply = server->create_reply(this->task_id());
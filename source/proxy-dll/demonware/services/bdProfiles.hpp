@@ -8,13 +8,13 @@ namespace demonware
 		bdProfiles();
 
 	private:
-		void getPublicInfos(service_server* server, byte_buffer* buffer) const;
-		void getPrivateInfo(service_server* server, byte_buffer* buffer) const;
-		void setPublicInfo(service_server* server, byte_buffer* buffer) const;
-		void setPrivateInfo(service_server* server, byte_buffer* buffer) const;
-		void deleteProfile(service_server* server, byte_buffer* buffer) const;
-		void setPrivateInfoByUserID(service_server* server, byte_buffer* buffer) const;
-		void getPrivateInfoByUserID(service_server* server, byte_buffer* buffer) const;
-		void setPublicInfoByUserID(service_server* server, byte_buffer* buffer) const;
+		void getPublicInfos(service_server* server, byte_buffer_view* buffer) const;
+		void getPrivateInfo(service_server* server, byte_buffer_view* buffer) const;
+		void setPublicInfo(service_server* server, byte_buffer_view* buffer) const;
+		void setPrivateInfo(service_server* server, byte_buffer_view* buffer) const;
+		void deleteProfile(service_server* server, byte_buffer_view* buffer) const;
+		void setPrivateInfoByUserID(service_server* server, byte_buffer_view* buffer) const;
+		void getPrivateInfoByUserID(service_server* server, byte_buffer_view* buffer) const;
+		void setPublicInfoByUserID(service_server* server, byte_buffer_view* buffer) const;
 	};
 }
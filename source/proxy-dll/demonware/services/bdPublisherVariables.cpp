@@ -8,7 +8,7 @@ namespace demonware
 		this->register_task(1, &bdPublisherVariables::retrievePublisherVariables);
 	}
 
-	void bdPublisherVariables::retrievePublisherVariables(service_server* server, byte_buffer* /*buffer*/) const
+	void bdPublisherVariables::retrievePublisherVariables(service_server* server, byte_buffer_view* /*buffer*/) const
 	{
 		// TODO:
 		auto reply = server->create_reply(this->task_id());
@@ -8,6 +8,6 @@ namespace demonware
 		bdPublisherVariables();
 
 	private:
-		void retrievePublisherVariables(service_server* server, byte_buffer* buffer) const;
+		void retrievePublisherVariables(service_server* server, byte_buffer_view* buffer) const;
 	};
 }
@@ -9,14 +9,14 @@ namespace demonware
 		this->register_task(2, &bdRichPresence::getInfo);
 	}
 
-	void bdRichPresence::setInfo(service_server* server, byte_buffer* /*buffer*/) const
+	void bdRichPresence::setInfo(service_server* server, byte_buffer_view* /*buffer*/) const
 	{
 		// TODO:
 		auto reply = server->create_reply(this->task_id());
 		reply->send();
 	}
 
-	void bdRichPresence::getInfo(service_server* server, byte_buffer* /*buffer*/) const
+	void bdRichPresence::getInfo(service_server* server, byte_buffer_view* /*buffer*/) const
 	{
 		// TODO:
 		auto reply = server->create_reply(this->task_id());
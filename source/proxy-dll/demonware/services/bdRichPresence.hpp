@@ -8,7 +8,7 @@ namespace demonware
 		bdRichPresence();
 
 	private:
-		void setInfo(service_server* server, byte_buffer* buffer) const;
-		void getInfo(service_server* server, byte_buffer* buffer) const;
+		void setInfo(service_server* server, byte_buffer_view* buffer) const;
+		void getInfo(service_server* server, byte_buffer_view* buffer) const;
 	};
 }
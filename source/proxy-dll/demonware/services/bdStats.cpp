@@ -20,91 +20,91 @@ namespace demonware
 		//this->register_task(14, &bdStats::writeServerValidatedStats);
 	}
 
-	void bdStats::writeStats(service_server* server, byte_buffer* /*buffer*/) const
+	void bdStats::writeStats(service_server* server, byte_buffer_view* /*buffer*/) const
 	{
 		// TODO:
 		auto reply = server->create_reply(this->task_id());
 		reply->send();
 	}
 
-	void bdStats::deleteStats(service_server* server, byte_buffer* /*buffer*/) const
+	void bdStats::deleteStats(service_server* server, byte_buffer_view* /*buffer*/) const
 	{
 		// TODO:
 		auto reply = server->create_reply(this->task_id());
 		reply->send();
 	}
 
-	void bdStats::readStatsByEntityID(service_server* server, byte_buffer* /*buffer*/) const
+	void bdStats::readStatsByEntityID(service_server* server, byte_buffer_view* /*buffer*/) const
 	{
 		// TODO:
 		auto reply = server->create_reply(this->task_id());
 		reply->send();
 	}
 
-	void bdStats::readStatsByRank(service_server* server, byte_buffer* /*buffer*/) const
+	void bdStats::readStatsByRank(service_server* server, byte_buffer_view* /*buffer*/) const
 	{
 		// TODO:
 		auto reply = server->create_reply(this->task_id());
 		reply->send();
 	}
 
-	void bdStats::readStatsByPivot(service_server* server, byte_buffer* /*buffer*/) const
+	void bdStats::readStatsByPivot(service_server* server, byte_buffer_view* /*buffer*/) const
 	{
 		// TODO:
 		auto reply = server->create_reply(this->task_id());
 		reply->send();
 	}
 
-	void bdStats::readStatsByRating(service_server* server, byte_buffer* /*buffer*/) const
+	void bdStats::readStatsByRating(service_server* server, byte_buffer_view* /*buffer*/) const
 	{
 		// TODO:
 		auto reply = server->create_reply(this->task_id());
 		reply->send();
 	}
 
-	void bdStats::readStatsByMultipleRanks(service_server* server, byte_buffer* /*buffer*/) const
+	void bdStats::readStatsByMultipleRanks(service_server* server, byte_buffer_view* /*buffer*/) const
 	{
 		// TODO:
 		auto reply = server->create_reply(this->task_id());
 		reply->send();
 	}
 
-	void bdStats::readExternalTitleStats(service_server* server, byte_buffer* /*buffer*/) const
+	void bdStats::readExternalTitleStats(service_server* server, byte_buffer_view* /*buffer*/) const
 	{
 		// TODO:
 		auto reply = server->create_reply(this->task_id());
 		reply->send();
 	}
 
-	void bdStats::readExternalTitleNamedStats(service_server* server, byte_buffer* /*buffer*/) const
+	void bdStats::readExternalTitleNamedStats(service_server* server, byte_buffer_view* /*buffer*/) const
 	{
 		// TODO:
 		auto reply = server->create_reply(this->task_id());
 		reply->send();
 	}
 
-	void bdStats::readStatsByLeaderboardIDsAndEntityIDs(service_server* server, byte_buffer* /*buffer*/) const
+	void bdStats::readStatsByLeaderboardIDsAndEntityIDs(service_server* server, byte_buffer_view* /*buffer*/) const
 	{
 		// TODO:
 		auto reply = server->create_reply(this->task_id());
 		reply->send();
 	}
 
-	void bdStats::readStatsByMultipleRatings(service_server* server, byte_buffer* /*buffer*/) const
+	void bdStats::readStatsByMultipleRatings(service_server* server, byte_buffer_view* /*buffer*/) const
 	{
 		// TODO:
 		auto reply = server->create_reply(this->task_id());
 		reply->send();
 	}
 
-	void bdStats::startTaskStatReadByEntityIDV2(service_server* server, byte_buffer* /*buffer*/) const
+	void bdStats::startTaskStatReadByEntityIDV2(service_server* server, byte_buffer_view* /*buffer*/) const
 	{
 		// TODO:
 		auto reply = server->create_reply(this->task_id());
 		reply->send();
 	}
 
-	void bdStats::writeServerValidatedStats(service_server* server, byte_buffer* /*buffer*/) const
+	void bdStats::writeServerValidatedStats(service_server* server, byte_buffer_view* /*buffer*/) const
 	{
 		// TODO:
 		auto reply = server->create_reply(this->task_id());
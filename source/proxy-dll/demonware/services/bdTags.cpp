@@ -13,35 +13,35 @@ namespace demonware
 		this->register_task(5, &bdTags::searchByTagsBase);
 	}
 
-	void bdTags::getTagsForEntityIDs(service_server* server, byte_buffer* /*buffer*/) const
+	void bdTags::getTagsForEntityIDs(service_server* server, byte_buffer_view* /*buffer*/) const
 	{
 		// TODO:
 		auto reply = server->create_reply(this->task_id());
 		reply->send();
 	}
 
-	void bdTags::setTagsForEntityID(service_server* server, byte_buffer* /*buffer*/) const
+	void bdTags::setTagsForEntityID(service_server* server, byte_buffer_view* /*buffer*/) const
 	{
 		// TODO:
 		auto reply = server->create_reply(this->task_id());
 		reply->send();
 	}
 
-	void bdTags::removeTagsForEntityID(service_server* server, byte_buffer* /*buffer*/) const
+	void bdTags::removeTagsForEntityID(service_server* server, byte_buffer_view* /*buffer*/) const
 	{
 		// TODO:
 		auto reply = server->create_reply(this->task_id());
 		reply->send();
 	}
 	
-	void bdTags::removeAllTagsForEntityID(service_server* server, byte_buffer* /*buffer*/) const
+	void bdTags::removeAllTagsForEntityID(service_server* server, byte_buffer_view* /*buffer*/) const
 	{
 		// TODO:
 		auto reply = server->create_reply(this->task_id());
 		reply->send();
 	}
 	
-	void bdTags::searchByTagsBase(service_server* server, byte_buffer* /*buffer*/) const
+	void bdTags::searchByTagsBase(service_server* server, byte_buffer_view* /*buffer*/) const
 	{
 		std::vector<uint64_t> demo_ids = fileshare::fileshare_list_demo_ids();
 
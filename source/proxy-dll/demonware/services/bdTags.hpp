@@ -8,10 +8,10 @@ namespace demonware
 		bdTags();
 
 	private:
-		void getTagsForEntityIDs(service_server* server, byte_buffer* buffer) const;
-		void setTagsForEntityID(service_server* server, byte_buffer* buffer) const;
-		void removeTagsForEntityID(service_server* server, byte_buffer* buffer) const;
-		void removeAllTagsForEntityID(service_server* server, byte_buffer* buffer) const;
-		void searchByTagsBase(service_server* server, byte_buffer* buffer) const;
+		void getTagsForEntityIDs(service_server* server, byte_buffer_view* buffer) const;
+		void setTagsForEntityID(service_server* server, byte_buffer_view* buffer) const;
+		void removeTagsForEntityID(service_server* server, byte_buffer_view* buffer) const;
+		void removeAllTagsForEntityID(service_server* server, byte_buffer_view* buffer) const;
+		void searchByTagsBase(service_server* server, byte_buffer_view* buffer) const;
 	};
 }
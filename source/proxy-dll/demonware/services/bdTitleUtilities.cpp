@@ -14,7 +14,7 @@ namespace demonware
 		this->register_task(10, &bdTitleUtilities::getUserIDs);
 	}
 
-	void bdTitleUtilities::getServerTime(service_server* server, byte_buffer* /*buffer*/) const
+	void bdTitleUtilities::getServerTime(service_server* server, byte_buffer_view* /*buffer*/) const
 	{
 		auto* const time_result = new bdTimeStamp;
 		time_result->unix_time = uint32_t(time(nullptr));
@@ -24,42 +24,42 @@ namespace demonware
 		reply->send();
 	}
 
-	void bdTitleUtilities::verifyString(service_server* server, byte_buffer* /*buffer*/) const
+	void bdTitleUtilities::verifyString(service_server* server, byte_buffer_view* /*buffer*/) const
 	{
 		// TODO:
 		auto reply = server->create_reply(this->task_id());
 		reply->send();
 	}
 
-	void bdTitleUtilities::getTitleStats(service_server* server, byte_buffer* /*buffer*/) const
+	void bdTitleUtilities::getTitleStats(service_server* server, byte_buffer_view* /*buffer*/) const
 	{
 		// TODO:
 		auto reply = server->create_reply(this->task_id());
 		reply->send();
 	}
 
-	void bdTitleUtilities::areUsersOnline(service_server* server, byte_buffer* /*buffer*/) const
+	void bdTitleUtilities::areUsersOnline(service_server* server, byte_buffer_view* /*buffer*/) const
 	{
 		// TODO:
 		auto reply = server->create_reply(this->task_id());
 		reply->send();
 	}
 
-	void bdTitleUtilities::getMAC(service_server* server, byte_buffer* /*buffer*/) const
+	void bdTitleUtilities::getMAC(service_server* server, byte_buffer_view* /*buffer*/) const
 	{
 		// TODO:
 		auto reply = server->create_reply(this->task_id());
 		reply->send();
 	}
 
-	void bdTitleUtilities::getUserNames(service_server* server, byte_buffer* /*buffer*/) const
+	void bdTitleUtilities::getUserNames(service_server* server, byte_buffer_view* /*buffer*/) const
 	{
 		// TODO:
 		auto reply = server->create_reply(this->task_id());
 		reply->send();
 	}
 
-	void bdTitleUtilities::getUserIDs(service_server* server, byte_buffer* /*buffer*/) const
+	void bdTitleUtilities::getUserIDs(service_server* server, byte_buffer_view* /*buffer*/) const
 	{
 		// TODO:
 		auto reply = server->create_reply(this->task_id());
@@ -8,12 +8,12 @@ namespace demonware
 		bdTitleUtilities();
 
 	private:
-		void verifyString(service_server* server, byte_buffer* buffer) const;
-		void getTitleStats(service_server* server, byte_buffer* buffer) const;
-		void getServerTime(service_server* server, byte_buffer* buffer) const;
-		void areUsersOnline(service_server* server, byte_buffer* buffer) const;
-		void getMAC(service_server* server, byte_buffer* buffer) const;
-		void getUserNames(service_server* server, byte_buffer* buffer) const;
-		void getUserIDs(service_server* server, byte_buffer* buffer) const;
+		void verifyString(service_server* server, byte_buffer_view* buffer) const;
+		void getTitleStats(service_server* server, byte_buffer_view* buffer) const;
+		void getServerTime(service_server* server, byte_buffer_view* buffer) const;
+		void areUsersOnline(service_server* server, byte_buffer_view* buffer) const;
+		void getMAC(service_server* server, byte_buffer_view* buffer) const;
+		void getUserNames(service_server* server, byte_buffer_view* buffer) const;
+		void getUserIDs(service_server* server, byte_buffer_view* buffer) const;
 	};
 }
@@ -11,28 +11,28 @@ namespace demonware
 		this->register_task(9, &bdUNK125::task_unk9);
 	}
 
-	void bdUNK125::task_unk1(service_server* server, byte_buffer* /*buffer*/) const
+	void bdUNK125::task_unk1(service_server* server, byte_buffer_view* /*buffer*/) const
 	{
 		// TODO:
 		auto reply = server->create_structed_reply(this->task_id());
 		reply->send("");
 	}
 	
-	void bdUNK125::task_unk2(service_server* server, byte_buffer* /*buffer*/) const
+	void bdUNK125::task_unk2(service_server* server, byte_buffer_view* /*buffer*/) const
 	{
 		// TODO:
 		auto reply = server->create_structed_reply(this->task_id());
 		reply->send("");
 	}
 	
-	void bdUNK125::task_unk3(service_server* server, byte_buffer* /*buffer*/) const
+	void bdUNK125::task_unk3(service_server* server, byte_buffer_view* /*buffer*/) const
 	{
 		// TODO:
 		auto reply = server->create_structed_reply(this->task_id());
 		reply->send("");
 	}
 	
-	void bdUNK125::task_unk9(service_server* server, byte_buffer* /*buffer*/) const
+	void bdUNK125::task_unk9(service_server* server, byte_buffer_view* /*buffer*/) const
 	{
 		// TODO:
 		auto reply = server->create_structed_reply(this->task_id());
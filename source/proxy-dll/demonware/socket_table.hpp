@@ -0,0 +1,128 @@
+#pragma once
+
+namespace demonware
+{
+	// socket keyed lookup table for the winsock hooks, lookups never take a lock:
+	// sockets land in a fixed slot picked from their handle bits, colliding ones go
+	// to an overflow map which is copied and republished on every change
+	template <typename T>
+	class socket_table
+	{
+		static_assert(std::is_trivially_copyable_v<T>, "Invalid socket table type");
+
+		using overflow_map = std::unordered_map<SOCKET, T>;
+
+	public:
+		T find(const SOCKET socket, const T def = {}) const
+		{
+			const auto& slot = this->slots_[index(socket)];
+			if (slot.socket.load(std::memory_order_acquire) == socket)
+			{
+				const auto value = slot.value.load(std::memory_order_acquire);
+				if (slot.socket.load(std::memory_order_acquire) == socket)
+				{
+					return value;
+				}
+			}
+
+			if (!this->overflow_count_.load(std::memory_order_acquire))
+			{
+				return def;
+			}
+
+			const auto overflow = this->overflow_.load(std::memory_order_acquire);
+			const auto entry = overflow->find(socket);
+			if (entry == overflow->end())
+			{
+				return def;
+			}
+
+			return entry->second;
+		}
+
+		void insert(const SOCKET socket, const T value)
+		{
+			std::lock_guard<std::mutex> _(this->mutex_);
+
+			const auto overflow = this->overflow_.load(std::memory_order_relaxed);
+			if (overflow->contains(socket))
+			{
+				this->publish_overflow([&](overflow_map& map)
+				{
+					map[socket] = value;
+				});
+				return;
+			}
+
+			auto& slot = this->slots_[index(socket)];
+			const auto current = slot.socket.load(std::memory_order_relaxed);
+
+			if (current == socket)
+			{
+				slot.value.store(value, std::memory_order_release);
+				return;
+			}
+
+			if (current == INVALID_SOCKET)
+			{
+				slot.value.store(value, std::memory_order_relaxed);
+				slot.socket.store(socket, std::memory_order_release);
+				return;
+			}
+
+			this->publish_overflow([&](overflow_map& map)
+			{
+				map[socket] = value;
+			});
+		}
+
+		void remove(const SOCKET socket)
+		{
+			std::lock_guard<std::mutex> _(this->mutex_);
+
+			auto& slot = this->slots_[index(socket)];
+			if (slot.socket.load(std::memory_order_relaxed) == socket)
+			{
+				slot.socket.store(INVALID_SOCKET, std::memory_order_release);
+			}
+			else if (this->overflow_.load(std::memory_order_relaxed)->contains(socket))
+			{
+				this->publish_overflow([&](overflow_map& map)
+				{
+					map.erase(socket);
+				});
+			}
+		}
+
+	private:
+		static constexpr size_t slot_count = 4096;
+
+		struct slot
+		{
+			std::atomic<SOCKET> socket{INVALID_SOCKET};
+			std::atomic<T> value{};
+		};
+
+		std::array<slot, slot_count> slots_{};
+		std::atomic<std::shared_ptr<const overflow_map>> overflow_{std::make_shared<const overflow_map>()};
+		std::atomic<size_t> overflow_count_{0};
+
+		std::mutex mutex_{};
+
+		static size_t index(const SOCKET socket)
+		{
+			// socket handles are kernel handles, the low two bits are always clear
+			return (static_cast<size_t>(socket) >> 2) & (slot_count - 1);
+		}
+
+		template <typename F>
+		void publish_overflow(F&& modifier)
+		{
+			auto copy = std::make_shared<overflow_map>(*this->overflow_.load(std::memory_order_relaxed));
+			modifier(*copy);
+
+			this->overflow_count_.store(copy->size(), std::memory_order_release);
+			this->overflow_.store(std::move(copy), std::memory_order_release);
+		}
+	};
+}
@@ -55,10 +55,16 @@
 #endif
 
 #include <map>
+#include <set>
+#include <unordered_map>
+#include <array>
 #include <atomic>
 #include <vector>
 #include <mutex>
+#include <condition_variable>
 #include <queue>
+#include <deque>
+#include <bit>
 #include <regex>
 #include <chrono>
 #include <thread>
@@ -69,6 +75,8 @@
 #include <functional>
 #include <sstream>
 #include <optional>
+#include <span>
+#include <charconv>
 #include <unordered_set>
 #include <variant>
 #include <cassert>
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <mutex>
+#include <array>
+#include <atomic>
 
 namespace utilities::concurrency
 {
@@ -43,4 +45,48 @@ namespace utilities::concurrency
 		mutable MutexType mutex_{};
 		T object_{};
 	};
+
+	// bounded single producer / single consumer ring, push fails once it is full
+	template <typename T, size_t Capacity>
+	class spsc_queue
+	{
+		static_assert((Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+	public:
+		bool push(T value)
+		{
+			const auto head = head_.load(std::memory_order_relaxed);
+			if (head - tail_.load(std::memory_order_acquire) == Capacity)
+			{
+				return false;
+			}
+
+			slots_[head & (Capacity - 1)] = std::move(value);
+			head_.store(head + 1, std::memory_order_release);
+			return true;
+		}
+
+		bool pop(T& value)
+		{
+			const auto tail = tail_.load(std::memory_order_relaxed);
+			if (tail == head_.load(std::memory_order_acquire))
+			{
+				return false;
+			}
+
+			value = std::move(slots_[tail & (Capacity - 1)]);
+			tail_.store(tail + 1, std::memory_order_release);
+			return true;
+		}
+
+		bool empty() const
+		{
+			return tail_.load(std::memory_order_acquire) == head_.load(std::memory_order_acquire);
+		}
+
+	private:
+		std::array<T, Capacity> slots_{};
+		alignas(64) std::atomic<size_t> head_{0};
+		alignas(64) std::atomic<size_t> tail_{0};
+	};
 }
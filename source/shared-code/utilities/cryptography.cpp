@@ -487,14 +487,30 @@ namespace utilities::cryptography
 		return dec_data;
 	}
 
+	void aes::encrypt(uint8_t* data, const size_t length, const std::string& iv, const std::string& key)
+	{
+		symmetric_CBC cbc;
+		const auto aes = find_cipher("aes");
+
+		cbc_start(aes, cs(iv.data()), cs(key.data()),
+		          static_cast<int>(key.size()), 0, &cbc);
+		cbc_encrypt(data, data, ul(length), &cbc);
+		cbc_done(&cbc);
+	}
+
 	std::string hmac_sha1::compute(const std::string& data, const std::string& key)
+	{
+		return compute(cs(data.data()), data.size(), key);
+	}
+
+	std::string hmac_sha1::compute(const uint8_t* data, const size_t length, const std::string& key)
 	{
 		std::string buffer;
 		buffer.resize(20);
 
 		hmac_state state;
 		hmac_init(&state, find_hash("sha1"), cs(key.data()), ul(key.size()));
-		hmac_process(&state, cs(data.data()), static_cast<int>(data.size()));
+		hmac_process(&state, data, ul(length));
 
 		auto out_len = ul(buffer.size());
 		hmac_done(&state, cs(buffer.data()), &out_len);
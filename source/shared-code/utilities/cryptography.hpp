@@ -73,11 +73,13 @@ namespace utilities::cryptography
 	{
 		std::string encrypt(const std::string& data, const std::string& iv, const std::string& key);
 		std::string decrypt(const std::string& data, const std::string& iv, const std::string& key);
+		void encrypt(uint8_t* data, size_t length, const std::string& iv, const std::string& key);
 	}
 
 	namespace hmac_sha1
 	{
 		std::string compute(const std::string& data, const std::string& key);
+		std::string compute(const uint8_t* data, size_t length, const std::string& key);
 	}
 
 	namespace sha1